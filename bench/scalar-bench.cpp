@@ -0,0 +1,162 @@
+// Compares the scalar variants of the per-sample kernels on the same inputs:
+// time per call and largest deviation from the double results.
+
+#include <liblrn/scalar.hpp>
+#include <liblrn/kinematics.hpp>
+#include <liblrn/ir-conversion.hpp>
+#include <liblrn/pose-estimator.hpp>
+#include <liblrn/potential-field-navigator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+using namespace lrn;
+
+namespace {
+
+constexpr std::size_t sample_count = 4096;
+constexpr int repetitions = 200;
+
+struct Inputs {
+    std::vector<double> v, w;
+    std::vector<double> adc;
+    std::vector<double> goal_dx, goal_dy;
+    std::vector<IrObservations> ir;
+    std::vector<double> gyro;
+};
+
+Inputs make_inputs() {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> speed(-0.5, 0.5);
+    std::uniform_real_distribution<double> rate(-1.0, 1.0);
+    std::uniform_real_distribution<double> adc(90.0, 700.0);
+    std::uniform_real_distribution<double> offset(-3.0, 3.0);
+    std::uniform_real_distribution<double> range(0.05, 0.8);
+
+    Inputs in;
+    for(std::size_t i = 0; i < sample_count; i++) {
+        in.v.push_back(speed(rng));
+        in.w.push_back(rate(rng));
+        in.adc.push_back(std::round(adc(rng)));
+        in.goal_dx.push_back(offset(rng));
+        in.goal_dy.push_back(offset(rng));
+        IrObservations obstacles;
+        for(std::size_t k = 0; k < ir_sensors_count; k++) {
+            const double rho = range(rng);
+            const double theta = ir_sensors_theta_start - static_cast<double>(k) * ir_sensors_delta;
+            obstacles[k] = IrObservation{{rho * std::cos(theta), rho * std::sin(theta)}, rho};
+        }
+        in.ir.push_back(obstacles);
+        in.gyro.push_back(rate(rng));
+    }
+    return in;
+}
+
+template<class F>
+double time_ns(F&& f) {
+    const auto t0 = std::chrono::steady_clock::now();
+    for(int r = 0; r < repetitions; r++) {
+        f();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    return elapsed / (static_cast<double>(repetitions) * static_cast<double>(sample_count));
+}
+
+template<Scalar T>
+std::vector<double> kinematics(const Inputs& in) {
+    std::vector<double> out(2 * sample_count);
+    for(std::size_t i = 0; i < sample_count; i++) {
+        const auto wheels = twist_to_wheels(static_cast<T>(in.v[i]), static_cast<T>(in.w[i]), T {0.468}, T {0.1});
+        out[2 * i] = static_cast<double>(wheels.left);
+        out[2 * i + 1] = static_cast<double>(wheels.right);
+    }
+    return out;
+}
+
+template<Scalar T>
+std::vector<double> ir_conversion(const Inputs& in) {
+    std::vector<double> out(sample_count);
+    for(std::size_t i = 0; i < sample_count; i++) {
+        out[i] = static_cast<double>(ir_adc_to_distance(static_cast<T>(in.adc[i])));
+    }
+    return out;
+}
+
+template<Scalar T>
+std::vector<double> navigator(const Inputs& in) {
+    std::vector<double> out(sample_count);
+    for(std::size_t i = 0; i < sample_count; i++) {
+        out[i] = static_cast<double>(potential_field_direction(static_cast<T>(in.goal_dx[i]), static_cast<T>(in.goal_dy[i]), in.ir[i], T {0.1}, T {50.0}, T {0.3}));
+    }
+    return out;
+}
+
+template<std::floating_point T>
+std::vector<double> estimator(const Inputs& in) {
+    static const PoseEstimatorConfig config;
+    BasicPoseEstimator<T> ekf(config);
+    auto stamp = std::chrono::steady_clock::time_point {};
+    std::vector<double> out(sample_count);
+    for(std::size_t i = 0; i < sample_count; i++) {
+        stamp += std::chrono::milliseconds(10);
+        ekf.predict(stamp);
+        ekf.observe_command({in.v[i], in.w[i]});
+        ekf.observe_gyro_z(in.gyro[i]);
+        out[i] = ekf.estimate().state.theta;
+    }
+    return out;
+}
+
+double max_error(const std::vector<double>& a, const std::vector<double>& b) {
+    double e = 0.0;
+    for(std::size_t i = 0; i < a.size(); i++) {
+        e = std::max(e, std::abs(a[i] - b[i]));
+    }
+    return e;
+}
+
+template<class Kernel>
+void report(std::string_view kernel, std::string_view type, Kernel&& run, const std::vector<double>& reference) {
+    std::vector<double> out;
+    const double ns = time_ns([&] { out = run(); });
+    fmt::print("{:<12} {:<7} {:>9.1f} ns {:>12.3g}\n", kernel, type, ns, max_error(out, reference));
+}
+
+} // namespace
+
+int main() {
+    const Inputs in = make_inputs();
+
+    fmt::print("{:<12} {:<7} {:>12} {:>12}\n", "kernel", "type", "per call", "max error");
+
+    const auto kin = kinematics<double>(in);
+    report("kinematics", "double", [&] { return kinematics<double>(in); }, kin);
+    report("kinematics", "float", [&] { return kinematics<float>(in); }, kin);
+    report("kinematics", "q16", [&] { return kinematics<Q16>(in); }, kin);
+
+    const auto ir = ir_conversion<double>(in);
+    report("ir", "double", [&] { return ir_conversion<double>(in); }, ir);
+    report("ir", "float", [&] { return ir_conversion<float>(in); }, ir);
+    report("ir", "q16", [&] { return ir_conversion<Q16>(in); }, ir);
+
+    const auto nav = navigator<double>(in);
+    report("navigator", "double", [&] { return navigator<double>(in); }, nav);
+    report("navigator", "float", [&] { return navigator<float>(in); }, nav);
+    report("navigator", "q16", [&] { return navigator<Q16>(in); }, nav);
+
+    // The estimator runs in float on fixed-point builds
+    const auto ekf = estimator<double>(in);
+    report("estimator", "double", [&] { return estimator<double>(in); }, ekf);
+    report("estimator", "float", [&] { return estimator<float>(in); }, ekf);
+
+    return 0;
+}
@@ -1,5 +1,10 @@
 include(cmake/folders.cmake)
 
+include(CTest)
+if(BUILD_TESTING)
+  add_subdirectory(test)
+endif()
+
 add_custom_target(
     run-exe
     COMMAND lrn_exe
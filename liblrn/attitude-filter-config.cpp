@@ -0,0 +1,21 @@
+#include <liblrn/attitude-filter-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <string_view>
+
+namespace lrn {
+
+AttitudeFilterConfig tag_invoke( boost::json::value_to_tag< AttitudeFilterConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    AttitudeFilterConfig config;
+    extract_optional( obj, config.beta, AttitudeFilterConfig::CONFIG_BETA);
+    extract_optional( obj, config.max_dt, AttitudeFilterConfig::CONFIG_MAX_DT);
+
+    return config;
+}
+
+} // namespace lrn
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <string_view>
+
+namespace lrn {
+
+class AttitudeFilterConfig
+{
+public:
+    static constexpr std::string_view CONFIG_BETA = {"beta"};
+    static constexpr std::string_view CONFIG_MAX_DT = {"max_dt"};
+
+    double beta = 0.05;     // gradient descent gain, trades gyro drift against accelerometer noise
+    double max_dt = 0.1;    // longest integration step, longer gaps are clamped (s)
+};
+
+AttitudeFilterConfig tag_invoke( boost::json::value_to_tag< AttitudeFilterConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
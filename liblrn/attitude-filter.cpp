@@ -0,0 +1,90 @@
+#include <liblrn/attitude-filter.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace lrn {
+
+namespace {
+double norm(const std::array<double, 3>& v) {
+    return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+}
+
+AttitudeFilter::AttitudeFilter(const AttitudeFilterConfig& cfg)
+    : config(cfg)
+{}
+
+void AttitudeFilter::align(const std::array<double, 3>& acc) {
+    const double roll = std::atan2(acc[1], acc[2]);
+    const double pitch = std::atan2(-acc[0], std::hypot(acc[1], acc[2]));
+    const double cr = std::cos(roll / 2.0);
+    const double sr = std::sin(roll / 2.0);
+    const double cp = std::cos(pitch / 2.0);
+    const double sp = std::sin(pitch / 2.0);
+    attitude_.q = {cr * cp, sr * cp, cr * sp, -sr * sp};
+}
+
+void AttitudeFilter::update(const std::array<double, 3>& gyro, const std::array<double, 3>& acc, std::chrono::steady_clock::time_point stamp) {
+    const double acc_norm = norm(acc);
+    if(!initialised_) {
+        if(acc_norm > 0.0) {
+            align(acc);
+        }
+        stamp_ = stamp;
+        initialised_ = true;
+    }
+    const double dt = std::clamp(std::chrono::duration<double>(stamp - stamp_).count(), 0.0, config.max_dt);
+    stamp_ = stamp;
+
+    auto& [q0, q1, q2, q3] = attitude_.q;
+    const double gx = gyro[0];
+    const double gy = gyro[1];
+    const double gz = gyro[2];
+
+    // Rate of change of the quaternion from the gyro
+    double qd0 = 0.5 * (-q1 * gx - q2 * gy - q3 * gz);
+    double qd1 = 0.5 * (q0 * gx + q2 * gz - q3 * gy);
+    double qd2 = 0.5 * (q0 * gy - q1 * gz + q3 * gx);
+    double qd3 = 0.5 * (q0 * gz + q1 * gy - q2 * gx);
+
+    // Gradient descent step towards the measured gravity direction
+    if(acc_norm > 0.0) {
+        const double ax = acc[0] / acc_norm;
+        const double ay = acc[1] / acc_norm;
+        const double az = acc[2] / acc_norm;
+
+        const double f0 = 2.0 * (q1 * q3 - q0 * q2) - ax;
+        const double f1 = 2.0 * (q0 * q1 + q2 * q3) - ay;
+        const double f2 = 2.0 * (0.5 - q1 * q1 - q2 * q2) - az;
+
+        double s0 = -2.0 * q2 * f0 + 2.0 * q1 * f1;
+        double s1 = 2.0 * q3 * f0 + 2.0 * q0 * f1 - 4.0 * q1 * f2;
+        double s2 = -2.0 * q0 * f0 + 2.0 * q3 * f1 - 4.0 * q2 * f2;
+        double s3 = 2.0 * q1 * f0 + 2.0 * q2 * f1;
+        const double s_norm = std::sqrt(s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3);
+        if(s_norm > 0.0) {
+            qd0 -= config.beta * s0 / s_norm;
+            qd1 -= config.beta * s1 / s_norm;
+            qd2 -= config.beta * s2 / s_norm;
+            qd3 -= config.beta * s3 / s_norm;
+        }
+    }
+
+    q0 += qd0 * dt;
+    q1 += qd1 * dt;
+    q2 += qd2 * dt;
+    q3 += qd3 * dt;
+    const double q_norm = std::sqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    q0 /= q_norm;
+    q1 /= q_norm;
+    q2 /= q_norm;
+    q3 /= q_norm;
+
+    attitude_.roll = std::atan2(2.0 * (q0 * q1 + q2 * q3), 1.0 - 2.0 * (q1 * q1 + q2 * q2));
+    attitude_.pitch = std::asin(std::clamp(2.0 * (q0 * q2 - q3 * q1), -1.0, 1.0));
+    // World z component of the body rate, the third row of the rotation matrix
+    attitude_.yaw_rate = 2.0 * (q1 * q3 - q0 * q2) * gx + 2.0 * (q2 * q3 + q0 * q1) * gy + (1.0 - 2.0 * (q1 * q1 + q2 * q2)) * gz;
+}
+
+} // namespace lrn
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+
+#include <liblrn/geometry.hpp>
+#include <liblrn/attitude-filter-config.hpp>
+
+namespace lrn {
+
+/**
+ * @brief Madgwick attitude filter fusing the accelerometer and the gyro.
+ *
+ * One gradient descent step per IMU sample, constant cost. The heading is
+ * left to the pose estimator: without a magnetometer only roll and pitch are
+ * observable. The first sample aligns the quaternion with gravity.
+ */
+class AttitudeFilter {
+public:
+    explicit AttitudeFilter(const AttitudeFilterConfig& cfg);
+
+    /**
+     * @brief Updates with a gyro sample (rad/s) and the latest accelerometer sample (any unit).
+     */
+    void update(const std::array<double, 3>& gyro, const std::array<double, 3>& acc, std::chrono::steady_clock::time_point stamp);
+
+    Attitude attitude() const { return attitude_; }
+
+private:
+    void align(const std::array<double, 3>& acc);
+
+    const AttitudeFilterConfig& config;
+    Attitude attitude_;
+    std::chrono::steady_clock::time_point stamp_ {};
+    bool initialised_ = false;
+};
+
+} // namespace lrn
@@ -0,0 +1,29 @@
+#include <liblrn/control-loop-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <stdexcept>
+#include <string_view>
+
+namespace lrn {
+
+ControlLoopConfig tag_invoke( boost::json::value_to_tag< ControlLoopConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    ControlLoopConfig config;
+    extract_optional( obj, config.period_ms, ControlLoopConfig::CONFIG_PERIOD_MS);
+    extract_optional( obj, config.budget_ms, ControlLoopConfig::CONFIG_BUDGET_MS);
+    extract_optional( obj, config.max_missed_deadlines, ControlLoopConfig::CONFIG_MAX_MISSED_DEADLINES);
+    extract_optional( obj, config.stats_period_ms, ControlLoopConfig::CONFIG_STATS_PERIOD_MS);
+
+    // The watchdog divides by the period and the loop would spin without one
+    if(config.period_ms <= 0 || config.budget_ms <= 0) {
+        throw std::invalid_argument("Control loop period_ms and budget_ms must be positive");
+    }
+
+    return config;
+}
+
+} // namespace lrn
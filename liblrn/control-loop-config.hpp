@@ -0,0 +1,24 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <string_view>
+
+namespace lrn {
+
+class ControlLoopConfig
+{
+public:
+    static constexpr std::string_view CONFIG_PERIOD_MS = {"period_ms"};
+    static constexpr std::string_view CONFIG_BUDGET_MS = {"budget_ms"};
+    static constexpr std::string_view CONFIG_MAX_MISSED_DEADLINES = {"max_missed_deadlines"};
+    static constexpr std::string_view CONFIG_STATS_PERIOD_MS = {"stats_period_ms"};
+
+    int period_ms = 50;             // navigator step period
+    int budget_ms = 40;             // time a single step may take
+    int max_missed_deadlines = 3;   // consecutive misses before the watchdog stops the wheels
+    int stats_period_ms = 1000;     // step time statistics publishing period
+};
+
+ControlLoopConfig tag_invoke( boost::json::value_to_tag< ControlLoopConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
@@ -0,0 +1,26 @@
+#include <liblrn/dstar-lite-planner-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <string_view>
+
+namespace lrn {
+
+DStarLitePlannerConfig tag_invoke( boost::json::value_to_tag< DStarLitePlannerConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    DStarLitePlannerConfig config;
+    extract_optional( obj, config.enabled, DStarLitePlannerConfig::CONFIG_ENABLED);
+    extract_optional( obj, config.resolution, DStarLitePlannerConfig::CONFIG_RESOLUTION);
+    extract_optional( obj, config.width, DStarLitePlannerConfig::CONFIG_WIDTH);
+    extract_optional( obj, config.height, DStarLitePlannerConfig::CONFIG_HEIGHT);
+    extract_optional( obj, config.period_ms, DStarLitePlannerConfig::CONFIG_PERIOD_MS);
+    extract_optional( obj, config.max_compute_ms, DStarLitePlannerConfig::CONFIG_MAX_COMPUTE_MS);
+    extract_optional( obj, config.lookahead, DStarLitePlannerConfig::CONFIG_LOOKAHEAD);
+
+    return config;
+}
+
+} // namespace lrn
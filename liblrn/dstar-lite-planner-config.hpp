@@ -0,0 +1,30 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <string_view>
+
+namespace lrn {
+
+class DStarLitePlannerConfig
+{
+public:
+    static constexpr std::string_view CONFIG_ENABLED = {"enabled"};
+    static constexpr std::string_view CONFIG_RESOLUTION = {"resolution"};
+    static constexpr std::string_view CONFIG_WIDTH = {"width"};
+    static constexpr std::string_view CONFIG_HEIGHT = {"height"};
+    static constexpr std::string_view CONFIG_PERIOD_MS = {"period_ms"};
+    static constexpr std::string_view CONFIG_MAX_COMPUTE_MS = {"max_compute_ms"};
+    static constexpr std::string_view CONFIG_LOOKAHEAD = {"lookahead"};
+
+    bool enabled = true;
+    double resolution = 0.1;    // cell size (m)
+    int width = 200;            // cells
+    int height = 200;           // cells
+    int period_ms = 100;        // planning cycle
+    int max_compute_ms = 20;    // search budget per cycle
+    double lookahead = 0.3;     // distance along the path used as local goal (m)
+};
+
+DStarLitePlannerConfig tag_invoke( boost::json::value_to_tag< DStarLitePlannerConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
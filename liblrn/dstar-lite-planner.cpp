@@ -0,0 +1,308 @@
+#include <liblrn/dstar-lite-planner.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <numbers>
+
+#include <boost/log/trivial.hpp>
+#include <fmt/format.h>
+
+namespace lrn {
+
+namespace {
+constexpr double infinity = std::numeric_limits<double>::infinity();
+}
+
+Vec2 path_lookahead(const PlannedPath& path, const Vec2& pos, double distance) {
+    if(path.waypoints.empty()) {
+        return path.goal;
+    }
+    // Closest waypoint first, then walk forward until far enough
+    std::size_t closest = 0;
+    double closest_dist = infinity;
+    for(std::size_t i = 0; i < path.waypoints.size(); i++) {
+        const double d = std::hypot(path.waypoints[i].x - pos.x, path.waypoints[i].y - pos.y);
+        if(d < closest_dist) {
+            closest_dist = d;
+            closest = i;
+        }
+    }
+    for(std::size_t i = closest; i < path.waypoints.size(); i++) {
+        if(std::hypot(path.waypoints[i].x - pos.x, path.waypoints[i].y - pos.y) >= distance) {
+            return path.waypoints[i];
+        }
+    }
+    return path.waypoints.back();
+}
+
+DStarLitePlanner::DStarLitePlanner(DStarLitePlannerConfig &cfg)
+    : config(cfg)
+    , grid_(cfg.resolution, cfg.width, cfg.height)
+    , g_(static_cast<std::size_t>(cfg.width) * static_cast<std::size_t>(cfg.height), infinity)
+    , rhs_(g_.size(), infinity)
+{}
+
+DStarLitePlanner::~DStarLitePlanner() {
+    stop();
+}
+
+void DStarLitePlanner::start(Rover& rover) {
+    should_stop_ = false;
+    planner_thread_ = std::thread(&DStarLitePlanner::run, this, std::ref(rover));
+}
+
+void DStarLitePlanner::stop() {
+    should_stop_ = true;
+    if(planner_thread_.joinable()) {
+        planner_thread_.join();
+    }
+}
+
+void DStarLitePlanner::run(Rover& rover) {
+    const auto period = std::chrono::milliseconds(config.period_ms);
+    while(!should_stop_) {
+        const auto cycle_start = std::chrono::steady_clock::now();
+        cycle(rover);
+        std::this_thread::sleep_until(cycle_start + period);
+    }
+}
+
+GridCell DStarLitePlanner::cell_of(std::size_t s) const {
+    const auto width = static_cast<std::size_t>(grid_.width());
+    return {static_cast<int>(s % width), static_cast<int>(s / width)};
+}
+
+template<class F>
+void DStarLitePlanner::for_each_neighbour(std::size_t s, F&& f) const {
+    const GridCell c = cell_of(s);
+    for(int dy = -1; dy <= 1; dy++) {
+        for(int dx = -1; dx <= 1; dx++) {
+            const GridCell n {c.x + dx, c.y + dy};
+            if((dx != 0 || dy != 0) && grid_.contains(n)) {
+                f(grid_.index(n));
+            }
+        }
+    }
+}
+
+double DStarLitePlanner::heuristic(std::size_t a, std::size_t b) const {
+    // Octile distance, admissible for 8-connected moves
+    const GridCell ca = cell_of(a);
+    const GridCell cb = cell_of(b);
+    const auto dx = static_cast<double>(std::abs(ca.x - cb.x));
+    const auto dy = static_cast<double>(std::abs(ca.y - cb.y));
+    return grid_.resolution() * (std::max(dx, dy) + (std::numbers::sqrt2 - 1.0) * std::min(dx, dy));
+}
+
+double DStarLitePlanner::cost(std::size_t a, std::size_t b) const {
+    // The cell under the rover is never considered blocked
+    auto blocked = [this](const GridCell& c) {
+        return grid_.index(c) != start_ && grid_.is_occupied(c);
+    };
+
+    const GridCell ca = cell_of(a);
+    const GridCell cb = cell_of(b);
+    if(blocked(ca) || blocked(cb)) {
+        return infinity;
+    }
+    if(ca.x != cb.x && ca.y != cb.y) {
+        // No corner cutting on diagonal moves
+        if(blocked({cb.x, ca.y}) || blocked({ca.x, cb.y})) {
+            return infinity;
+        }
+        return grid_.resolution() * std::numbers::sqrt2;
+    }
+    return grid_.resolution();
+}
+
+DStarLitePlanner::Key DStarLitePlanner::calculate_key(std::size_t s) const {
+    const double m = std::min(g_[s], rhs_[s]);
+    return {m + heuristic(start_, s) + km_, m};
+}
+
+void DStarLitePlanner::update_vertex(std::size_t u) {
+    if(u != *goal_) {
+        double best = infinity;
+        for_each_neighbour(u, [&](std::size_t v) {
+            best = std::min(best, cost(u, v) + g_[v]);
+        });
+        rhs_[u] = best;
+    }
+    // Stale queue entries are discarded lazily when popped
+    if(g_[u] < rhs_[u] || rhs_[u] < g_[u]) {
+        open_.emplace(calculate_key(u), u);
+    }
+}
+
+void DStarLitePlanner::reset(const GridCell& start, const GridCell& goal) {
+    std::fill(g_.begin(), g_.end(), infinity);
+    std::fill(rhs_.begin(), rhs_.end(), infinity);
+    open_ = {};
+    km_ = 0.0;
+    start_ = grid_.index(start);
+    last_ = start_;
+    goal_ = grid_.index(goal);
+    rhs_[*goal_] = 0.0;
+    open_.emplace(calculate_key(*goal_), *goal_);
+    search_complete_ = false;
+}
+
+bool DStarLitePlanner::compute_shortest_path(std::chrono::steady_clock::time_point deadline) {
+    auto consistent = [this](std::size_t s) {
+        return !(g_[s] < rhs_[s]) && !(rhs_[s] < g_[s]);
+    };
+
+    std::size_t expansions = 0;
+    while(!open_.empty()) {
+        const auto [k_old, u] = open_.top();
+        if(!(k_old < calculate_key(start_)) && consistent(start_)) {
+            break;
+        }
+        if((++expansions % 64) == 0 && std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        open_.pop();
+
+        if(consistent(u)) {
+            continue;
+        }
+        const Key k_new = calculate_key(u);
+        if(k_old < k_new) {
+            open_.emplace(k_new, u);
+        } else if(g_[u] > rhs_[u]) {
+            g_[u] = rhs_[u];
+            for_each_neighbour(u, [this](std::size_t s) { update_vertex(s); });
+        } else {
+            g_[u] = infinity;
+            update_vertex(u);
+            for_each_neighbour(u, [this](std::size_t s) { update_vertex(s); });
+        }
+    }
+    return true;
+}
+
+void DStarLitePlanner::integrate_sensors(const RobotState& state, const SensorReading& sensors, std::vector<GridCell>& changed) {
+    for(std::size_t i = 0; i < ir_sensors_count; i++) {
+        if(!sensors.ir[i]) {
+            continue;
+        }
+        const double rho = *sensors.ir[i];
+        const double theta = state.theta + ir_sensors_theta_start - static_cast<double>(i) * ir_sensors_delta;
+        const Vec2 end {state.pos.x + rho * std::cos(theta), state.pos.y + rho * std::sin(theta)};
+        grid_.integrate_ray(state.pos, end, rho < ir_max_range - 1e-3, changed);
+    }
+}
+
+void DStarLitePlanner::publish_path(const Vec2& goal) {
+    auto path = std::make_shared<PlannedPath>();
+    path->goal = goal;
+    path->sequence = ++sequence_;
+
+    if(g_[start_] < infinity) {
+        std::size_t s = start_;
+        const std::size_t max_steps = g_.size();
+        for(std::size_t step = 0; step < max_steps && s != *goal_; step++) {
+            path->waypoints.push_back(grid_.cell_to_world(cell_of(s)));
+            std::size_t next = s;
+            double best = infinity;
+            for_each_neighbour(s, [&](std::size_t v) {
+                const double c = cost(s, v) + g_[v];
+                if(c < best) {
+                    best = c;
+                    next = v;
+                }
+            });
+            if(next == s) {
+                break;
+            }
+            s = next;
+        }
+        path->waypoints.push_back(goal);
+        BOOST_LOG_TRIVIAL(debug) << fmt::format("[planner]: path #{} with {} waypoints, cost {:.2f}", path->sequence, path->waypoints.size(), g_[start_]);
+    } else {
+        BOOST_LOG_TRIVIAL(warning) << fmt::format("[planner]: no path to goal ({:.2f}, {:.2f})", goal.x, goal.y);
+    }
+
+    path_.store(std::move(path), std::memory_order_release);
+    path_published_ = true;
+}
+
+void DStarLitePlanner::clear_path() {
+    if(path_published_) {
+        path_.store(nullptr, std::memory_order_release);
+        path_published_ = false;
+    }
+}
+
+void DStarLitePlanner::cycle(Rover& rover) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(config.max_compute_ms);
+
+    const auto state = rover.getState();
+    const auto sensors = rover.readSensors();
+    const Vec2 goal = rover.getGoalPosition();
+
+    const auto start_cell = grid_.world_to_cell(state.pos);
+    const auto goal_cell = grid_.world_to_cell(goal);
+    if(!start_cell || !goal_cell) {
+        BOOST_LOG_TRIVIAL(warning) << fmt::format("[planner]: rover ({:.2f}, {:.2f}) or goal ({:.2f}, {:.2f}) outside of the map", state.pos.x, state.pos.y, goal.x, goal.y);
+        clear_path();
+        return;
+    }
+
+    // With no waypoint the goal follows the rover: keep mapping but do not re-seed
+    // the search on every cell the rover crosses
+    if(*start_cell == *goal_cell) {
+        std::vector<GridCell> changed;
+        integrate_sensors(rover.getStateAt(sensors.stamp).value_or(state), sensors, changed);
+        if(!changed.empty()) {
+            goal_.reset();
+        }
+        clear_path();
+        return;
+    }
+
+    if(!goal_ || *goal_ != grid_.index(*goal_cell)) {
+        reset(*start_cell, *goal_cell);
+    }
+    goal_position_ = goal;
+
+    std::vector<GridCell> changed;
+    const std::size_t previous_start = start_;
+    start_ = grid_.index(*start_cell);
+    if(start_ != previous_start) {
+        // The cell under the rover is exempt from blocking, so both ends may change cost
+        if(grid_.is_occupied(cell_of(previous_start))) {
+            changed.push_back(cell_of(previous_start));
+        }
+        if(grid_.is_occupied(*start_cell)) {
+            changed.push_back(*start_cell);
+        }
+        search_complete_ = false;
+    }
+
+    // Rays start from where the rover was when the IR sampled
+    integrate_sensors(rover.getStateAt(sensors.stamp).value_or(state), sensors, changed);
+
+    if(!changed.empty()) {
+        km_ += heuristic(last_, start_);
+        last_ = start_;
+        for(const auto& cell : changed) {
+            const std::size_t s = grid_.index(cell);
+            update_vertex(s);
+            for_each_neighbour(s, [this](std::size_t v) { update_vertex(v); });
+        }
+        search_complete_ = false;
+    }
+
+    if(!search_complete_) {
+        search_complete_ = compute_shortest_path(deadline);
+        if(search_complete_) {
+            publish_path(goal_position_);
+        }
+    }
+}
+
+} // namespace lrn
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <liblrn/rover.hpp>
+#include <liblrn/occupancy-grid.hpp>
+#include <liblrn/dstar-lite-planner-config.hpp>
+
+namespace lrn {
+
+struct PlannedPath {
+    std::vector<Vec2> waypoints;    // from the rover position to the goal
+    Vec2 goal;
+    std::uint64_t sequence;
+};
+
+/**
+ * @brief Returns the point of the path at the given distance ahead of pos.
+ */
+Vec2 path_lookahead(const PlannedPath& path, const Vec2& pos, double distance);
+
+/**
+ * @brief Global planner running D* Lite on the occupancy grid built from IR readings.
+ *
+ * The search runs backwards from the goal, so when cells change only the
+ * affected vertices are repaired instead of planning from scratch. Each cycle
+ * spends at most max_compute_ms searching; an unfinished search resumes on the
+ * next cycle. The last complete path is published to the navigators through
+ * an atomic shared_ptr. It is not lock-free, so it is only written when a
+ * search completes or the path is withdrawn, never on every cycle.
+ */
+class DStarLitePlanner {
+public:
+    explicit DStarLitePlanner(DStarLitePlannerConfig &cfg);
+    ~DStarLitePlanner();
+
+    void start(Rover& rover);
+    void stop();
+
+    std::shared_ptr<const PlannedPath> current_path() const {
+        return path_.load(std::memory_order_acquire);
+    }
+
+private:
+    using Key = std::pair<double, double>;
+    using QueueEntry = std::pair<Key, std::size_t>;
+
+    void run(Rover& rover);
+    void cycle(Rover& rover);
+
+    void integrate_sensors(const RobotState& state, const SensorReading& sensors, std::vector<GridCell>& changed);
+    void reset(const GridCell& start, const GridCell& goal);
+    bool compute_shortest_path(std::chrono::steady_clock::time_point deadline);
+    void update_vertex(std::size_t u);
+    void publish_path(const Vec2& goal);
+    void clear_path();
+
+    double heuristic(std::size_t a, std::size_t b) const;
+    double cost(std::size_t a, std::size_t b) const;
+    Key calculate_key(std::size_t s) const;
+
+    template<class F>
+    void for_each_neighbour(std::size_t s, F&& f) const;
+
+    GridCell cell_of(std::size_t s) const;
+
+    DStarLitePlannerConfig& config;
+    OccupancyGrid grid_;
+
+    std::vector<double> g_;
+    std::vector<double> rhs_;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> open_;
+    double km_ = 0.0;
+    std::size_t start_ = 0;
+    std::size_t last_ = 0;
+    std::optional<std::size_t> goal_;
+    Vec2 goal_position_ {0, 0};
+    bool search_complete_ = false;
+    std::uint64_t sequence_ = 0;
+
+    std::atomic<std::shared_ptr<const PlannedPath>> path_;
+    bool path_published_ = false;
+
+    std::atomic<bool> should_stop_ {false};
+    std::thread planner_thread_;
+};
+
+} // namespace lrn
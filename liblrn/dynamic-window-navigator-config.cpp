@@ -0,0 +1,31 @@
+#include <liblrn/dynamic-window-navigator-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <string_view>
+
+namespace lrn {
+
+DynamicWindowNavigatorConfig tag_invoke( boost::json::value_to_tag< DynamicWindowNavigatorConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    DynamicWindowNavigatorConfig config;
+    extract_optional( obj, config.V_SAMPLES, DynamicWindowNavigatorConfig::CONFIG_V_SAMPLES);
+    extract_optional( obj, config.W_SAMPLES, DynamicWindowNavigatorConfig::CONFIG_W_SAMPLES);
+    extract_optional( obj, config.DT, DynamicWindowNavigatorConfig::CONFIG_DT);
+    extract_optional( obj, config.HORIZON, DynamicWindowNavigatorConfig::CONFIG_HORIZON);
+    extract_optional( obj, config.SIM_STEPS, DynamicWindowNavigatorConfig::CONFIG_SIM_STEPS);
+    extract_optional( obj, config.K_HEADING, DynamicWindowNavigatorConfig::CONFIG_K_HEADING);
+    extract_optional( obj, config.K_CLEARANCE, DynamicWindowNavigatorConfig::CONFIG_K_CLEARANCE);
+    extract_optional( obj, config.K_VELOCITY, DynamicWindowNavigatorConfig::CONFIG_K_VELOCITY);
+    extract_optional( obj, config.ROBOT_RADIUS, DynamicWindowNavigatorConfig::CONFIG_ROBOT_RADIUS);
+    extract_optional( obj, config.CLEARANCE_MAX, DynamicWindowNavigatorConfig::CONFIG_CLEARANCE_MAX);
+    extract_optional( obj, config.GOAL_TOLERANCE, DynamicWindowNavigatorConfig::CONFIG_GOAL_TOLERANCE);
+    extract_optional( obj, config.WORKERS, DynamicWindowNavigatorConfig::CONFIG_WORKERS);
+
+    return config;
+}
+
+} // namespace lrn
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <string_view>
+
+namespace lrn {
+
+class DynamicWindowNavigatorConfig
+{
+public:
+    static constexpr std::string_view CONFIG_V_SAMPLES = {"V_SAMPLES"};
+    static constexpr std::string_view CONFIG_W_SAMPLES = {"W_SAMPLES"};
+    static constexpr std::string_view CONFIG_DT = {"DT"};
+    static constexpr std::string_view CONFIG_HORIZON = {"HORIZON"};
+    static constexpr std::string_view CONFIG_SIM_STEPS = {"SIM_STEPS"};
+    static constexpr std::string_view CONFIG_K_HEADING = {"K_HEADING"};
+    static constexpr std::string_view CONFIG_K_CLEARANCE = {"K_CLEARANCE"};
+    static constexpr std::string_view CONFIG_K_VELOCITY = {"K_VELOCITY"};
+    static constexpr std::string_view CONFIG_ROBOT_RADIUS = {"ROBOT_RADIUS"};
+    static constexpr std::string_view CONFIG_CLEARANCE_MAX = {"CLEARANCE_MAX"};
+    static constexpr std::string_view CONFIG_GOAL_TOLERANCE = {"GOAL_TOLERANCE"};
+    static constexpr std::string_view CONFIG_WORKERS = {"WORKERS"};
+
+    int V_SAMPLES = 64;
+    int W_SAMPLES = 64;
+    double DT = 0.05;               // control period (s)
+    double HORIZON = 1.5;           // forward simulation time (s)
+    int SIM_STEPS = 15;
+    double K_HEADING = 0.8;
+    double K_CLEARANCE = 0.2;
+    double K_VELOCITY = 0.1;
+    double ROBOT_RADIUS = 0.3;      // m
+    double CLEARANCE_MAX = 1.0;     // clearance above this is not rewarded (m)
+    double GOAL_TOLERANCE = 0.1;    // m
+    int WORKERS = 0;                // extra threads for trajectory scoring
+};
+
+DynamicWindowNavigatorConfig tag_invoke( boost::json::value_to_tag< DynamicWindowNavigatorConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
@@ -0,0 +1,231 @@
+#include <liblrn/dynamic-window-navigator.hpp>
+#include <liblrn/simd.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include <boost/log/trivial.hpp>
+#include <fmt/format.h>
+
+namespace lrn {
+
+void TrajectoryBatch::resize(std::size_t n) {
+    const std::size_t padded = (n + simd::float_lanes - 1) / simd::float_lanes * simd::float_lanes;
+    v.resize(padded);
+    w.resize(padded);
+    step.resize(padded);
+    cos_dtheta.resize(padded);
+    sin_dtheta.resize(padded);
+    margin.resize(padded);
+    score.resize(padded);
+    feasible.resize(padded);
+}
+
+DynamicWindowNavigator::DynamicWindowNavigator(Rover& rover, const RoverConfig& rover_cfg, DynamicWindowNavigatorConfig& cfg, const DStarLitePlanner *planner, double lookahead)
+    : rover_(rover)
+    , config(cfg)
+    , planner_(planner)
+    , lookahead_(lookahead)
+    , half_wheelbase_(rover_cfg.wheelbase / 2.0)
+    , max_rim_speed_(rover_cfg.wheel_radius * rover_cfg.max_wheel_speed)
+    , v_max_(max_rim_speed_)
+    , w_max_(max_rim_speed_ / half_wheelbase_)
+    , a_max_(rover_cfg.wheel_radius * rover_cfg.max_wheel_acceleration)
+    , alpha_max_(a_max_ / half_wheelbase_)
+{
+    batch_.resize(static_cast<std::size_t>(config.V_SAMPLES) * static_cast<std::size_t>(config.W_SAMPLES));
+    if(config.WORKERS > 0) {
+        pool_ = std::make_unique<ThreadPool>(static_cast<std::size_t>(config.WORKERS));
+    }
+}
+
+void DynamicWindowNavigator::sample_window() {
+    // Velocities reachable within one control period
+    const double v_lo = std::max(0.0, v_cmd_ - a_max_ * config.DT);
+    const double v_hi = std::min(v_max_, v_cmd_ + a_max_ * config.DT);
+    const double w_lo = std::max(-w_max_, w_cmd_ - alpha_max_ * config.DT);
+    const double w_hi = std::min(w_max_, w_cmd_ + alpha_max_ * config.DT);
+
+    const auto nv = static_cast<std::size_t>(config.V_SAMPLES);
+    const auto nw = static_cast<std::size_t>(config.W_SAMPLES);
+    const double dv = nv > 1 ? (v_hi - v_lo) / static_cast<double>(nv - 1) : 0.0;
+    const double dw = nw > 1 ? (w_hi - w_lo) / static_cast<double>(nw - 1) : 0.0;
+    const double dt_sim = config.HORIZON / config.SIM_STEPS;
+
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < nv; i++) {
+        for(std::size_t j = 0; j < nw; j++, n++) {
+            const double v = v_lo + static_cast<double>(i) * dv;
+            const double w = w_lo + static_cast<double>(j) * dw;
+            batch_.v[n] = static_cast<float>(v);
+            batch_.w[n] = static_cast<float>(w);
+            batch_.step[n] = static_cast<float>(v * dt_sim);
+            batch_.cos_dtheta[n] = static_cast<float>(std::cos(w * dt_sim));
+            batch_.sin_dtheta[n] = static_cast<float>(std::sin(w * dt_sim));
+            // Both wheels must stay within their speed limit
+            batch_.feasible[n] = std::abs(v) + std::abs(w) * half_wheelbase_ <= max_rim_speed_ + 1e-9;
+        }
+    }
+    // Padding lanes repeat a stationary command and are never selected
+    for(; n < batch_.size(); n++) {
+        batch_.v[n] = 0.0f;
+        batch_.w[n] = 0.0f;
+        batch_.step[n] = 0.0f;
+        batch_.cos_dtheta[n] = 1.0f;
+        batch_.sin_dtheta[n] = 0.0f;
+        batch_.feasible[n] = 0;
+    }
+}
+
+void DynamicWindowNavigator::score_range(std::size_t begin, std::size_t end, const Vec2& goal, const LocalObstacles& obstacles) {
+    using namespace simd;
+
+    const f32x4 zero = broadcast(0.0f);
+    const f32x4 one = broadcast(1.0f);
+    const f32x4 half = broadcast(0.5f);
+    const f32x4 epsilon = broadcast(1e-9f);
+    const f32x4 gx = broadcast(static_cast<float>(goal.x));
+    const f32x4 gy = broadcast(static_cast<float>(goal.y));
+    const f32x4 radius = broadcast(static_cast<float>(config.ROBOT_RADIUS));
+    const f32x4 no_obstacle = broadcast(static_cast<float>(config.CLEARANCE_MAX + config.ROBOT_RADIUS));
+    const f32x4 inv_2a = broadcast(static_cast<float>(1.0 / (2.0 * a_max_)));
+    const f32x4 inv_clearance_max = broadcast(static_cast<float>(1.0 / config.CLEARANCE_MAX));
+    const f32x4 inv_v_max = broadcast(static_cast<float>(1.0 / v_max_));
+    const f32x4 k_heading = broadcast(static_cast<float>(config.K_HEADING));
+    const f32x4 k_clearance = broadcast(static_cast<float>(config.K_CLEARANCE));
+    const f32x4 k_velocity = broadcast(static_cast<float>(config.K_VELOCITY));
+
+    for(std::size_t i = begin; i < end; i += float_lanes) {
+        const f32x4 v = load(&batch_.v[i]);
+        const f32x4 step = load(&batch_.step[i]);
+        const f32x4 cd = load(&batch_.cos_dtheta[i]);
+        const f32x4 sd = load(&batch_.sin_dtheta[i]);
+
+        f32x4 x = zero;
+        f32x4 y = zero;
+        f32x4 c = one;
+        f32x4 s = zero;
+        f32x4 min_d2 = no_obstacle * no_obstacle;
+
+        // Forward-simulate the arcs, the heading advances by a fixed rotation per step
+        for(int k = 0; k < config.SIM_STEPS; k++) {
+            const f32x4 cn = c * cd - s * sd;
+            s = mul_add(s, cd, c * sd);
+            c = cn;
+            x = mul_add(step, c, x);
+            y = mul_add(step, s, y);
+
+            for(std::size_t j = 0; j < obstacles.count; j++) {
+                const f32x4 dx = x - broadcast(obstacles.x[j]);
+                const f32x4 dy = y - broadcast(obstacles.y[j]);
+                min_d2 = min(min_d2, mul_add(dx, dx, dy * dy));
+            }
+        }
+
+        // Clearance left once the rover brakes to a stop
+        const f32x4 d2 = min_d2 + epsilon;
+        const f32x4 clearance = d2 * rsqrt(d2) - radius;
+        const f32x4 margin = clearance - v * v * inv_2a;
+
+        // Alignment of the final heading with the goal direction, in [0, 1]
+        const f32x4 ex = gx - x;
+        const f32x4 ey = gy - y;
+        const f32x4 e2 = mul_add(ex, ex, ey * ey) + epsilon;
+        const f32x4 alignment = half * (one + mul_add(ex, c, ey * s) * rsqrt(e2));
+
+        const f32x4 clearance_term = min(max(clearance, zero) * inv_clearance_max, one);
+        const f32x4 score = mul_add(k_heading, alignment, mul_add(k_clearance, clearance_term, k_velocity * v * inv_v_max));
+
+        store(&batch_.margin[i], margin);
+        store(&batch_.score[i], score);
+    }
+}
+
+void DynamicWindowNavigator::step() {
+    const auto t0 = std::chrono::steady_clock::now();
+
+    const auto state = rover_.getState();
+    Vec2 goal = rover_.getGoalPosition();
+    const auto observations = rover_.readObstacles();
+
+    if (planner_) {
+        const auto path = planner_->current_path();
+        if (path && !path->waypoints.empty()) {
+            goal = path_lookahead(*path, state.pos, lookahead_);
+        }
+    }
+
+    if (std::hypot(goal.x - state.pos.x, goal.y - state.pos.y) < config.GOAL_TOLERANCE) {
+        v_cmd_ = 0.0;
+        w_cmd_ = 0.0;
+        rover_.drive(0.0, 0.0);
+        return;
+    }
+
+    // Goal and obstacles in the rover frame
+    const double ct = std::cos(state.theta);
+    const double st = std::sin(state.theta);
+    const double gdx = goal.x - state.pos.x;
+    const double gdy = goal.y - state.pos.y;
+    const Vec2 goal_local {ct * gdx + st * gdy, -st * gdx + ct * gdy};
+
+    LocalObstacles obstacles {};
+    for (const auto& observation : observations) {
+        if (observation && observation->range < ir_max_range - 1e-3) {
+            obstacles.x[obstacles.count] = static_cast<float>(observation->point.x);
+            obstacles.y[obstacles.count] = static_cast<float>(observation->point.y);
+            obstacles.count++;
+        }
+    }
+
+    sample_window();
+
+    if (pool_) {
+        pool_->parallel_for(batch_.size(), simd::float_lanes, [&](std::size_t begin, std::size_t end) {
+            score_range(begin, end, goal_local, obstacles);
+        });
+    } else {
+        score_range(0, batch_.size(), goal_local, obstacles);
+    }
+
+    // Best admissible candidate; with none, turn in place towards the most clearance
+    std::size_t best = batch_.size();
+    float best_score = -std::numeric_limits<float>::infinity();
+    std::size_t fallback = batch_.size();
+    float fallback_margin = -std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < batch_.size(); i++) {
+        if (!batch_.feasible[i]) {
+            continue;
+        }
+        if (batch_.margin[i] > 0.0f && batch_.score[i] > best_score) {
+            best_score = batch_.score[i];
+            best = i;
+        }
+        if (batch_.margin[i] > fallback_margin + 1e-3f
+            || (batch_.margin[i] > fallback_margin - 1e-3f && fallback < batch_.size() && batch_.score[i] > batch_.score[fallback])) {
+            fallback_margin = std::max(fallback_margin, batch_.margin[i]);
+            fallback = i;
+        }
+    }
+
+    if (best < batch_.size()) {
+        v_cmd_ = batch_.v[best];
+        w_cmd_ = batch_.w[best];
+    } else if (fallback < batch_.size()) {
+        v_cmd_ = 0.0;
+        w_cmd_ = batch_.w[fallback];
+        BOOST_LOG_TRIVIAL(debug) << fmt::format("[dwa]: no admissible trajectory, turning in place w={:.2f}", w_cmd_);
+    } else {
+        v_cmd_ = 0.0;
+        w_cmd_ = 0.0;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0);
+    BOOST_LOG_TRIVIAL(trace) << fmt::format("[dwa]: {} candidates in {} us, v={:.2f} w={:.2f}", batch_.size(), elapsed.count(), v_cmd_, w_cmd_);
+
+    rover_.drive(v_cmd_, w_cmd_);
+}
+
+} // namespace lrn
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <liblrn/navigator.hpp>
+#include <liblrn/rover.hpp>
+#include <liblrn/rover-config.hpp>
+#include <liblrn/dynamic-window-navigator-config.hpp>
+#include <liblrn/dstar-lite-planner.hpp>
+#include <liblrn/thread-pool.hpp>
+
+namespace lrn {
+
+/**
+ * @brief Candidate (v, w) commands and their scores, structure-of-arrays.
+ *
+ * The size is padded to a multiple of the SIMD width.
+ */
+struct TrajectoryBatch {
+    std::vector<float> v;
+    std::vector<float> w;
+    std::vector<float> step;        // distance travelled per simulation step
+    std::vector<float> cos_dtheta;  // rotation per simulation step
+    std::vector<float> sin_dtheta;
+    std::vector<float> margin;      // clearance left after braking (m), > 0 when admissible
+    std::vector<float> score;
+    std::vector<std::uint8_t> feasible;
+
+    void resize(std::size_t n);
+    std::size_t size() const { return v.size(); }
+};
+
+struct LocalObstacles {
+    std::array<float, ir_sensors_count> x;
+    std::array<float, ir_sensors_count> y;
+    std::size_t count;
+};
+
+/**
+ * @brief Dynamic Window Approach local planner.
+ *
+ * Samples (v, w) pairs reachable within one control period under the wheel
+ * acceleration limits, forward-simulates the arcs and scores them against
+ * goal heading, obstacle clearance and speed.
+ */
+class DynamicWindowNavigator : public Navigator {
+public:
+    DynamicWindowNavigator(Rover& rover, const RoverConfig& rover_cfg, DynamicWindowNavigatorConfig& cfg, const DStarLitePlanner *planner = nullptr, double lookahead = 0.3);
+
+    std::string_view name() const override { return "dynamic_window"; }
+    void step() override;
+
+private:
+    void sample_window();
+    void score_range(std::size_t begin, std::size_t end, const Vec2& goal, const LocalObstacles& obstacles);
+
+    Rover& rover_;
+    DynamicWindowNavigatorConfig& config;
+    const DStarLitePlanner *planner_;
+    double lookahead_;
+
+    double half_wheelbase_;
+    double max_rim_speed_;  // wheel_radius * max_wheel_speed
+    double v_max_;
+    double w_max_;
+    double a_max_;
+    double alpha_max_;
+
+    double v_cmd_ = 0.0;
+    double w_cmd_ = 0.0;
+
+    TrajectoryBatch batch_;
+    std::unique_ptr<ThreadPool> pool_;
+};
+
+} // namespace lrn
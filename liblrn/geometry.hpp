@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <numbers>
+
+namespace lrn {
+
+struct Vec2 {
+    double x, y;
+};
+
+struct Quaternion {
+    double w = 1.0, x = 0.0, y = 0.0, z = 0.0;
+};
+
+struct Attitude {
+    Quaternion q;           // body to world, world z up
+    double roll = 0.0;      // rad
+    double pitch = 0.0;     // rad
+    double yaw_rate = 0.0;  // rotation rate about the world vertical (rad/s)
+};
+
+struct RobotState {
+    Vec2 pos;
+    double theta;
+    Attitude attitude {};
+};
+
+struct Twist {
+    double v, w;    // linear (m/s) and angular (rad/s) velocity
+};
+
+// Wrap an angle to [-pi, pi)
+template<std::floating_point T>
+inline T wrap_angle(T a) {
+    constexpr T pi = std::numbers::pi_v<T>;
+    a = std::fmod(a + pi, T{2} * pi);
+    if(a < T{0}) {
+        a += T{2} * pi;
+    }
+    return a - pi;
+}
+
+} // namespace lrn
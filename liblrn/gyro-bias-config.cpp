@@ -0,0 +1,26 @@
+#include <liblrn/gyro-bias-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <string_view>
+
+namespace lrn {
+
+GyroBiasConfig tag_invoke( boost::json::value_to_tag< GyroBiasConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    GyroBiasConfig config;
+    extract_optional( obj, config.file, GyroBiasConfig::CONFIG_FILE);
+    extract_optional( obj, config.startup_samples, GyroBiasConfig::CONFIG_STARTUP_SAMPLES);
+    extract_optional( obj, config.window, GyroBiasConfig::CONFIG_WINDOW);
+    extract_optional( obj, config.acc_variance_threshold, GyroBiasConfig::CONFIG_ACC_VARIANCE_THRESHOLD);
+    extract_optional( obj, config.tracking_gain, GyroBiasConfig::CONFIG_TRACKING_GAIN);
+    extract_optional( obj, config.max_bias, GyroBiasConfig::CONFIG_MAX_BIAS);
+    extract_optional( obj, config.save_period_s, GyroBiasConfig::CONFIG_SAVE_PERIOD_S);
+
+    return config;
+}
+
+} // namespace lrn
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <string>
+#include <string_view>
+
+namespace lrn {
+
+class GyroBiasConfig
+{
+public:
+    static constexpr std::string_view CONFIG_FILE = {"file"};
+    static constexpr std::string_view CONFIG_STARTUP_SAMPLES = {"startup_samples"};
+    static constexpr std::string_view CONFIG_WINDOW = {"window"};
+    static constexpr std::string_view CONFIG_ACC_VARIANCE_THRESHOLD = {"acc_variance_threshold"};
+    static constexpr std::string_view CONFIG_TRACKING_GAIN = {"tracking_gain"};
+    static constexpr std::string_view CONFIG_MAX_BIAS = {"max_bias"};
+    static constexpr std::string_view CONFIG_SAVE_PERIOD_S = {"save_period_s"};
+
+    std::string file {"gyro-bias.json"};    // persisted bias, empty to disable
+    int startup_samples = 200;              // stationary samples averaged for the initial estimate
+    int window = 50;                        // samples in the acceleration variance window
+    double acc_variance_threshold = 1e-4;   // below it the rover is still (g^2)
+    double tracking_gain = 0.005;           // bias low-pass gain per stationary sample
+    double max_bias = 5.0;                  // larger estimates are rejected (dps)
+    int save_period_s = 60;
+};
+
+GyroBiasConfig tag_invoke( boost::json::value_to_tag< GyroBiasConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
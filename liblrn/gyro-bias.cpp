@@ -0,0 +1,149 @@
+#include <liblrn/gyro-bias.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+#include <boost/log/trivial.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace lrn {
+
+namespace {
+constexpr double still_command = 1e-3;
+}
+
+GyroBiasEstimator::GyroBiasEstimator(const GyroBiasConfig& cfg)
+    : config(cfg)
+    , window_(static_cast<std::size_t>(std::max(cfg.window, 2)), 0.0)
+    , last_save_(std::chrono::steady_clock::now())
+{}
+
+GyroBiasEstimator::~GyroBiasEstimator() {
+    save();
+}
+
+bool GyroBiasEstimator::accept(const std::array<double, 3>& bias) const {
+    return std::all_of(bias.begin(), bias.end(), [this](double b) { return std::isfinite(b) && std::abs(b) <= config.max_bias; });
+}
+
+void GyroBiasEstimator::load() {
+    // The configuration may have changed since construction
+    window_.assign(static_cast<std::size_t>(std::max(config.window, 2)), 0.0);
+    window_next_ = 0;
+    window_filled_ = 0;
+    window_sum_ = 0.0;
+    window_sum_sq_ = 0.0;
+
+    if(config.file.empty()) {
+        return;
+    }
+
+    std::ifstream file(config.file);
+    if(!file) {
+        BOOST_LOG_TRIVIAL(info) << fmt::format("[gyro-bias]: no stored bias in '{}', calibrating while still", config.file);
+        return;
+    }
+    try {
+        const json j = json::parse(file);
+        const auto bias = j.at("bias_dps").get<std::array<double, 3>>();
+        if(!accept(bias)) {
+            BOOST_LOG_TRIVIAL(warning) << fmt::format("[gyro-bias]: ignoring out of range stored bias in '{}'", config.file);
+            return;
+        }
+        bias_ = bias;
+        calibrated_ = true;
+        BOOST_LOG_TRIVIAL(info) << fmt::format("[gyro-bias]: loaded bias {:.3f}, {:.3f}, {:.3f} dps", bias_[0], bias_[1], bias_[2]);
+    } catch(const std::exception& e) {
+        BOOST_LOG_TRIVIAL(warning) << fmt::format("[gyro-bias]: failed to read '{}': {}", config.file, e.what());
+    }
+}
+
+void GyroBiasEstimator::save() {
+    if(!dirty_ || config.file.empty()) {
+        return;
+    }
+    dirty_ = false;
+    last_save_ = std::chrono::steady_clock::now();
+
+    // Write aside and rename, a crash never leaves a truncated file behind
+    const std::string tmp = config.file + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::trunc);
+        if(!file) {
+            BOOST_LOG_TRIVIAL(warning) << fmt::format("[gyro-bias]: cannot write '{}'", tmp);
+            return;
+        }
+        file << json{{"bias_dps", bias_}}.dump();
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, config.file, ec);
+    if(ec) {
+        BOOST_LOG_TRIVIAL(warning) << fmt::format("[gyro-bias]: cannot replace '{}': {}", config.file, ec.message());
+    }
+}
+
+void GyroBiasEstimator::add_acceleration(const std::array<double, 3>& acc_g) {
+    const double m = std::sqrt(acc_g[0] * acc_g[0] + acc_g[1] * acc_g[1] + acc_g[2] * acc_g[2]) - 1.0;
+    if(window_filled_ == window_.size()) {
+        const double old = window_[window_next_];
+        window_sum_ -= old;
+        window_sum_sq_ -= old * old;
+    } else {
+        window_filled_++;
+    }
+    window_[window_next_] = m;
+    window_sum_ += m;
+    window_sum_sq_ += m * m;
+    window_next_ = (window_next_ + 1) % window_.size();
+}
+
+std::array<double, 3> GyroBiasEstimator::correct(const std::array<double, 3>& rate_dps, const Twist& command) {
+    stationary_ = false;
+    if(window_filled_ == window_.size()
+        && std::abs(command.v) < still_command && std::abs(command.w) < still_command) {
+        const double n = static_cast<double>(window_filled_);
+        const double mean = window_sum_ / n;
+        stationary_ = window_sum_sq_ / n - mean * mean < config.acc_variance_threshold;
+    }
+
+    if(stationary_) {
+        if(!startup_done_) {
+            for(std::size_t i = 0; i < 3; i++) {
+                startup_sum_[i] += rate_dps[i];
+            }
+            if(++startup_count_ >= config.startup_samples) {
+                std::array<double, 3> average {};
+                for(std::size_t i = 0; i < 3; i++) {
+                    average[i] = startup_sum_[i] / static_cast<double>(startup_count_);
+                }
+                startup_done_ = true;
+                if(accept(average)) {
+                    bias_ = average;
+                    calibrated_ = true;
+                    dirty_ = true;
+                    BOOST_LOG_TRIVIAL(info) << fmt::format("[gyro-bias]: calibrated {:.3f}, {:.3f}, {:.3f} dps", bias_[0], bias_[1], bias_[2]);
+                } else {
+                    BOOST_LOG_TRIVIAL(warning) << "[gyro-bias]: startup average out of range, keeping the previous bias";
+                }
+            }
+        } else if(accept(rate_dps)) {
+            for(std::size_t i = 0; i < 3; i++) {
+                bias_[i] += config.tracking_gain * (rate_dps[i] - bias_[i]);
+            }
+            dirty_ = true;
+        }
+    }
+
+    if(dirty_ && std::chrono::steady_clock::now() - last_save_ >= std::chrono::seconds(config.save_period_s)) {
+        save();
+    }
+
+    return {rate_dps[0] - bias_[0], rate_dps[1] - bias_[1], rate_dps[2] - bias_[2]};
+}
+
+} // namespace lrn
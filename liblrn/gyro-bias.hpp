@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <liblrn/geometry.hpp>
+#include <liblrn/gyro-bias-config.hpp>
+
+namespace lrn {
+
+/**
+ * @brief Gyro bias estimation from the samples taken while the rover stands still.
+ *
+ * The rover counts as still when the commanded twist is zero and the
+ * variance of the acceleration magnitude over the last window is below the
+ * threshold. The first startup_samples still samples are averaged into the
+ * initial estimate, afterwards the bias follows a low-pass of the still
+ * samples. The estimate is stored to a file and loaded at start, so a stored
+ * bias is used right away while the startup average is collected.
+ *
+ * Stepped on the I/O thread with the IMU samples.
+ */
+class GyroBiasEstimator {
+public:
+    explicit GyroBiasEstimator(const GyroBiasConfig& cfg);
+    ~GyroBiasEstimator();
+
+    void load();
+    void save();
+
+    void add_acceleration(const std::array<double, 3>& acc_g);
+
+    /**
+     * @brief Updates the estimate with a raw sample and returns it bias-corrected (dps).
+     */
+    std::array<double, 3> correct(const std::array<double, 3>& rate_dps, const Twist& command);
+
+    bool calibrated() const { return calibrated_; }
+    bool stationary() const { return stationary_; }
+    const std::array<double, 3>& bias() const { return bias_; }
+
+private:
+    bool accept(const std::array<double, 3>& bias) const;
+
+    const GyroBiasConfig& config;
+
+    // Acceleration magnitude window, stored relative to 1 g
+    std::vector<double> window_;
+    std::size_t window_next_ = 0;
+    std::size_t window_filled_ = 0;
+    double window_sum_ = 0.0;
+    double window_sum_sq_ = 0.0;
+
+    std::array<double, 3> startup_sum_ {};
+    int startup_count_ = 0;
+    bool startup_done_ = false;
+
+    std::array<double, 3> bias_ {};
+    bool calibrated_ = false;
+    bool stationary_ = false;
+
+    bool dirty_ = false;
+    std::chrono::steady_clock::time_point last_save_;
+};
+
+} // namespace lrn
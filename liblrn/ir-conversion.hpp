@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+
+#include <liblrn/scalar.hpp>
+
+namespace lrn {
+
+typedef struct{
+  long int x;    // ADC value for the corresponding distance  (mm)
+  long int m;    // slope between current ADC value and the next one
+  long int mm;   // distance in mm from the sensor
+} LUT;
+
+constexpr size_t LUT_SIZE = 11;
+constexpr LUT ir_lut_values[LUT_SIZE] = {
+  {108, 17653, 800},  // slope: 17.2414
+  {113,  7475, 700},  // slope: 7.2988
+  {127, 10129, 600},  // slope: 9.8911
+  {138,  4212, 500},  // slope: 4.1126
+  {162,  2425, 400},  // slope: 2.3689
+  {204,  1281, 300},  // slope: 1.2508
+  {283,   463, 200},  // slope: 0.4528
+  {504,   193, 100},  // slope: 0.1885
+  {557,   190,  90},  // slope: 0.1861
+  {610,   183,  80},  // slope: 0.1792
+  {667,     0,  70}
+};
+
+/**
+ * @brief Converts an IR sensor ADC reading to a distance (m) with the LUT.
+ *
+ * Readings below the table are out of range (0.8 m), readings above it are
+ * clamped to the closest distance. Linear between entries, slope in mm per
+ * ADC count scaled by 1024.
+ */
+template<Scalar T>
+T ir_adc_to_distance(T adc) {
+    if(adc < T(ir_lut_values[0].x)) {
+        return T {0.8};
+    }
+    std::size_t i = 0;
+    while(i + 1 < LUT_SIZE && !(adc < T(ir_lut_values[i + 1].x))) {
+        i++;
+    }
+    const T dx = adc - T(ir_lut_values[i].x);
+    const T mm = T(ir_lut_values[i].mm) - T(ir_lut_values[i].m) / T {1024} * dx;
+    return mm / T {1000};
+}
+
+} // namespace lrn
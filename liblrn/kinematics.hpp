@@ -0,0 +1,31 @@
+#pragma once
+
+#include <utility>
+
+#include <liblrn/scalar.hpp>
+
+namespace lrn {
+
+template<Scalar T>
+struct WheelSpeeds {
+    T left, right;  // rad/s
+};
+
+/**
+ * @brief Differential drive inverse kinematics, (v, w) to wheel angular speeds.
+ */
+template<Scalar T>
+constexpr WheelSpeeds<T> twist_to_wheels(T v, T w, T wheelbase, T wheel_radius) {
+    const T half_track = wheelbase / T {2};
+    return {(v - half_track * w) / wheel_radius, (v + half_track * w) / wheel_radius};
+}
+
+/**
+ * @brief Differential drive forward kinematics, wheel angular speeds to (v, w).
+ */
+template<Scalar T>
+constexpr std::pair<T, T> wheels_to_twist(const WheelSpeeds<T>& wheels, T wheelbase, T wheel_radius) {
+    return {wheel_radius * (wheels.right + wheels.left) / T {2}, wheel_radius * (wheels.right - wheels.left) / wheelbase};
+}
+
+} // namespace lrn
@@ -4,6 +4,8 @@
 #include <boost/json/value.hpp>
 #include <boost/json/object.hpp>
 #include <boost/json/conversion.hpp>
+#include <fmt/format.h>
+#include <stdexcept>
 
 namespace lrn {
 
@@ -13,6 +15,17 @@ LRnConfig tag_invoke( boost::json::value_to_tag< LRnConfig > /*unused*/, boost::
     LRnConfig config;
     extract( obj, config.rover, LRnConfig::CONFIG_ROVER );
     extract( obj, config.navigator, LRnConfig::CONFIG_NAVIGATOR );
+    extract_optional( obj, config.local_planner, LRnConfig::CONFIG_LOCAL_PLANNER );
+    extract_optional( obj, config.dynamic_window, LRnConfig::CONFIG_DYNAMIC_WINDOW );
+    extract_optional( obj, config.planner, LRnConfig::CONFIG_PLANNER );
+    extract_optional( obj, config.mission, LRnConfig::CONFIG_MISSION );
+    extract_optional( obj, config.mpc, LRnConfig::CONFIG_MPC );
+    extract_optional( obj, config.control_loop, LRnConfig::CONFIG_CONTROL_LOOP );
+    extract_optional( obj, config.localization, LRnConfig::CONFIG_LOCALIZATION );
+
+    if(config.local_planner != LRnConfig::LOCAL_PLANNER_POTENTIAL_FIELD && config.local_planner != LRnConfig::LOCAL_PLANNER_DYNAMIC_WINDOW) {
+        throw std::invalid_argument(fmt::format("Unknown local planner '{}'", config.local_planner));
+    }
 
     return config;
 }
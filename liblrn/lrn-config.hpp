@@ -1,10 +1,18 @@
 #pragma once
 
+#include <string>
 #include <string_view>
+#include <optional>
 #include <boost/json.hpp>
 
 #include <liblrn/rover-config.hpp>
 #include <liblrn/potential-field-navigator-config.hpp>
+#include <liblrn/dynamic-window-navigator-config.hpp>
+#include <liblrn/dstar-lite-planner-config.hpp>
+#include <liblrn/mission-config.hpp>
+#include <liblrn/mpc-tracker-config.hpp>
+#include <liblrn/control-loop-config.hpp>
+#include <liblrn/monte-carlo-localizer-config.hpp>
 
 namespace lrn {
 
@@ -13,9 +21,26 @@ class LRnConfig
 public:
     static constexpr std::string_view CONFIG_ROVER = {"rover"};
     static constexpr std::string_view CONFIG_NAVIGATOR = {"navigator"};
+    static constexpr std::string_view CONFIG_LOCAL_PLANNER = {"local_planner"};
+    static constexpr std::string_view CONFIG_DYNAMIC_WINDOW = {"dynamic_window"};
+    static constexpr std::string_view CONFIG_PLANNER = {"planner"};
+    static constexpr std::string_view CONFIG_MISSION = {"mission"};
+    static constexpr std::string_view CONFIG_MPC = {"mpc"};
+    static constexpr std::string_view CONFIG_CONTROL_LOOP = {"control_loop"};
+    static constexpr std::string_view CONFIG_LOCALIZATION = {"localization"};
+
+    static constexpr std::string_view LOCAL_PLANNER_POTENTIAL_FIELD = {"potential_field"};
+    static constexpr std::string_view LOCAL_PLANNER_DYNAMIC_WINDOW = {"dynamic_window"};
 
     RoverConfig rover;
     PotentialFieldNavigatorConfig navigator;
+    std::string local_planner {LOCAL_PLANNER_POTENTIAL_FIELD};
+    DynamicWindowNavigatorConfig dynamic_window;
+    std::optional<DStarLitePlannerConfig> planner;
+    std::optional<MissionConfig> mission;
+    std::optional<MpcTrackerConfig> mpc;
+    ControlLoopConfig control_loop;
+    std::optional<MonteCarloLocalizerConfig> localization;
 
 };
 
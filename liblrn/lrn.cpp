@@ -21,7 +21,7 @@ void LRnManager::start() {
 
     BOOST_LOG_TRIVIAL(info) << fmt::format("Starting Navigation...");
     running = true;
-    rover_executor_thread = std::thread(&RoverExecutor::run, &rover_executor, std::ref(config.rover), std::ref(config.navigator));
+    rover_executor_thread = std::thread(&RoverExecutor::run, &rover_executor, std::ref(config));
     BOOST_LOG_TRIVIAL(info) << fmt::format("Starting Navigation...OK");
 }
 
@@ -0,0 +1,32 @@
+#include <liblrn/mission-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <string_view>
+
+namespace lrn {
+
+WaypointConfig tag_invoke( boost::json::value_to_tag< WaypointConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    WaypointConfig config;
+    extract( obj, config.x, WaypointConfig::CONFIG_X);
+    extract( obj, config.y, WaypointConfig::CONFIG_Y);
+    extract_optional( obj, config.tolerance, WaypointConfig::CONFIG_TOLERANCE);
+
+    return config;
+}
+
+MissionConfig tag_invoke( boost::json::value_to_tag< MissionConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    MissionConfig config;
+    extract( obj, config.waypoints, MissionConfig::CONFIG_WAYPOINTS);
+    extract_optional( obj, config.tolerance, MissionConfig::CONFIG_TOLERANCE);
+
+    return config;
+}
+
+} // namespace lrn
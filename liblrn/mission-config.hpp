@@ -0,0 +1,35 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <vector>
+#include <boost/json.hpp>
+
+namespace lrn {
+
+class WaypointConfig
+{
+public:
+    static constexpr std::string_view CONFIG_X = {"x"};
+    static constexpr std::string_view CONFIG_Y = {"y"};
+    static constexpr std::string_view CONFIG_TOLERANCE = {"tolerance"};
+
+    double x;
+    double y;
+    std::optional<double> tolerance;
+};
+
+class MissionConfig
+{
+public:
+    static constexpr std::string_view CONFIG_WAYPOINTS = {"waypoints"};
+    static constexpr std::string_view CONFIG_TOLERANCE = {"tolerance"};
+
+    std::vector<WaypointConfig> waypoints;
+    double tolerance = 0.1;     // default arrival tolerance (m)
+};
+
+WaypointConfig tag_invoke( boost::json::value_to_tag< WaypointConfig > /*unused*/, boost::json::value const& json_value );
+MissionConfig tag_invoke( boost::json::value_to_tag< MissionConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
@@ -0,0 +1,94 @@
+#include <liblrn/mission.hpp>
+
+#include <cmath>
+
+#include <boost/log/trivial.hpp>
+#include <fmt/format.h>
+
+namespace lrn {
+
+std::string_view to_string(MissionStatus status) {
+    switch(status) {
+    case MissionStatus::Idle: return "idle";
+    case MissionStatus::Active: return "active";
+    case MissionStatus::Completed: return "completed";
+    }
+    return "unknown";
+}
+
+Mission::Mission(double default_tolerance)
+    : default_tolerance_(default_tolerance)
+{}
+
+void Mission::configure(const MissionConfig& cfg) {
+    std::vector<Waypoint> waypoints;
+    waypoints.reserve(cfg.waypoints.size());
+    for(const auto& wp : cfg.waypoints) {
+        waypoints.push_back({{wp.x, wp.y}, wp.tolerance.value_or(cfg.tolerance)});
+    }
+    {
+        const std::lock_guard lock(mutex_);
+        default_tolerance_ = cfg.tolerance;
+    }
+    set_waypoints(std::move(waypoints));
+}
+
+double Mission::default_tolerance() const {
+    const std::lock_guard lock(mutex_);
+    return default_tolerance_;
+}
+
+void Mission::set_waypoints(std::vector<Waypoint> waypoints) {
+    const std::lock_guard lock(mutex_);
+    waypoints_ = std::move(waypoints);
+    current_ = 0;
+    distance_ = 0.0;
+    revision_++;
+    BOOST_LOG_TRIVIAL(info) << fmt::format("[mission]: {} waypoints loaded", waypoints_.size());
+}
+
+void Mission::append_waypoints(const std::vector<Waypoint>& waypoints) {
+    const std::lock_guard lock(mutex_);
+    waypoints_.insert(waypoints_.end(), waypoints.begin(), waypoints.end());
+    revision_++;
+    BOOST_LOG_TRIVIAL(info) << fmt::format("[mission]: {} waypoints appended, {} pending", waypoints.size(), waypoints_.size() - current_);
+}
+
+void Mission::clear() {
+    set_waypoints({});
+}
+
+std::optional<Vec2> Mission::update(const Vec2& position) {
+    const std::lock_guard lock(mutex_);
+    while(current_ < waypoints_.size()) {
+        const auto& wp = waypoints_[current_];
+        distance_ = std::hypot(wp.position.x - position.x, wp.position.y - position.y);
+        if(distance_ > wp.tolerance) {
+            return wp.position;
+        }
+        BOOST_LOG_TRIVIAL(info) << fmt::format("[mission]: waypoint {}/{} reached ({:.2f}, {:.2f})", current_ + 1, waypoints_.size(), wp.position.x, wp.position.y);
+        current_++;
+        revision_++;
+    }
+    return std::nullopt;
+}
+
+MissionProgress Mission::progress() const {
+    const std::lock_guard lock(mutex_);
+    MissionProgress progress {};
+    progress.current = current_;
+    progress.total = waypoints_.size();
+    progress.revision = revision_;
+    progress.distance = distance_;
+    if(waypoints_.empty()) {
+        progress.status = MissionStatus::Idle;
+    } else if(current_ < waypoints_.size()) {
+        progress.status = MissionStatus::Active;
+        progress.target = waypoints_[current_];
+    } else {
+        progress.status = MissionStatus::Completed;
+    }
+    return progress;
+}
+
+} // namespace lrn
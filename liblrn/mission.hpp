@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <liblrn/geometry.hpp>
+#include <liblrn/mission-config.hpp>
+
+namespace lrn {
+
+struct Waypoint {
+    Vec2 position;
+    double tolerance;
+};
+
+enum class MissionStatus {
+    Idle,
+    Active,
+    Completed,
+};
+
+std::string_view to_string(MissionStatus status);
+
+struct MissionProgress {
+    MissionStatus status;
+    std::size_t current;    // index of the active waypoint
+    std::size_t total;
+    std::optional<Waypoint> target;
+    double distance;        // to the active waypoint (m)
+    std::uint64_t revision;
+};
+
+/**
+ * @brief Ordered waypoint queue feeding goals to the active navigator.
+ *
+ * Waypoints can be replaced or appended at any time (remote API, nav.json);
+ * update() advances past every waypoint the rover is within tolerance of.
+ */
+class Mission {
+public:
+    explicit Mission(double default_tolerance = 0.1);
+
+    void configure(const MissionConfig& cfg);
+
+    void set_waypoints(std::vector<Waypoint> waypoints);
+    void append_waypoints(const std::vector<Waypoint>& waypoints);
+    void clear();
+
+    double default_tolerance() const;
+
+    /**
+     * @brief Advances the queue from the current position.
+     * @return the active goal, nothing when idle or completed
+     */
+    std::optional<Vec2> update(const Vec2& position);
+
+    MissionProgress progress() const;
+
+private:
+    mutable std::mutex mutex_;
+    double default_tolerance_;
+    std::vector<Waypoint> waypoints_;
+    std::size_t current_ = 0;
+    double distance_ = 0.0;
+    std::uint64_t revision_ = 0;
+};
+
+} // namespace lrn
@@ -0,0 +1,46 @@
+#include <liblrn/monte-carlo-localizer-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <string_view>
+
+namespace lrn {
+
+MonteCarloLocalizerConfig tag_invoke( boost::json::value_to_tag< MonteCarloLocalizerConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    MonteCarloLocalizerConfig config;
+    extract_optional( obj, config.enabled, MonteCarloLocalizerConfig::CONFIG_ENABLED);
+    extract_optional( obj, config.map_file, MonteCarloLocalizerConfig::CONFIG_MAP_FILE);
+    extract_optional( obj, config.period_ms, MonteCarloLocalizerConfig::CONFIG_PERIOD_MS);
+    extract_optional( obj, config.max_compute_ms, MonteCarloLocalizerConfig::CONFIG_MAX_COMPUTE_MS);
+    extract_optional( obj, config.workers, MonteCarloLocalizerConfig::CONFIG_WORKERS);
+    extract_optional( obj, config.min_particles, MonteCarloLocalizerConfig::CONFIG_MIN_PARTICLES);
+    extract_optional( obj, config.max_particles, MonteCarloLocalizerConfig::CONFIG_MAX_PARTICLES);
+    extract_optional( obj, config.kld_epsilon, MonteCarloLocalizerConfig::CONFIG_KLD_EPSILON);
+    extract_optional( obj, config.kld_z, MonteCarloLocalizerConfig::CONFIG_KLD_Z);
+    extract_optional( obj, config.bin_size, MonteCarloLocalizerConfig::CONFIG_BIN_SIZE);
+    extract_optional( obj, config.bin_angle, MonteCarloLocalizerConfig::CONFIG_BIN_ANGLE);
+    extract_optional( obj, config.resample_threshold, MonteCarloLocalizerConfig::CONFIG_RESAMPLE_THRESHOLD);
+    extract_optional( obj, config.update_min_distance, MonteCarloLocalizerConfig::CONFIG_UPDATE_MIN_DISTANCE);
+    extract_optional( obj, config.update_min_angle, MonteCarloLocalizerConfig::CONFIG_UPDATE_MIN_ANGLE);
+    extract_optional( obj, config.range_sigma, MonteCarloLocalizerConfig::CONFIG_RANGE_SIGMA);
+    extract_optional( obj, config.z_hit, MonteCarloLocalizerConfig::CONFIG_Z_HIT);
+    extract_optional( obj, config.z_rand, MonteCarloLocalizerConfig::CONFIG_Z_RAND);
+    extract_optional( obj, config.alpha_rot_rot, MonteCarloLocalizerConfig::CONFIG_ALPHA_ROT_ROT);
+    extract_optional( obj, config.alpha_rot_trans, MonteCarloLocalizerConfig::CONFIG_ALPHA_ROT_TRANS);
+    extract_optional( obj, config.alpha_trans_trans, MonteCarloLocalizerConfig::CONFIG_ALPHA_TRANS_TRANS);
+    extract_optional( obj, config.alpha_trans_rot, MonteCarloLocalizerConfig::CONFIG_ALPHA_TRANS_ROT);
+    extract_optional( obj, config.initial_x, MonteCarloLocalizerConfig::CONFIG_INITIAL_X);
+    extract_optional( obj, config.initial_y, MonteCarloLocalizerConfig::CONFIG_INITIAL_Y);
+    extract_optional( obj, config.initial_theta, MonteCarloLocalizerConfig::CONFIG_INITIAL_THETA);
+    extract_optional( obj, config.initial_sigma_xy, MonteCarloLocalizerConfig::CONFIG_INITIAL_SIGMA_XY);
+    extract_optional( obj, config.initial_sigma_theta, MonteCarloLocalizerConfig::CONFIG_INITIAL_SIGMA_THETA);
+    extract_optional( obj, config.cluster_radius, MonteCarloLocalizerConfig::CONFIG_CLUSTER_RADIUS);
+
+    return config;
+}
+
+} // namespace lrn
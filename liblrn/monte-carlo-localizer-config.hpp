@@ -0,0 +1,71 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <string>
+#include <string_view>
+
+namespace lrn {
+
+class MonteCarloLocalizerConfig
+{
+public:
+    static constexpr std::string_view CONFIG_ENABLED = {"enabled"};
+    static constexpr std::string_view CONFIG_MAP_FILE = {"map_file"};
+    static constexpr std::string_view CONFIG_PERIOD_MS = {"period_ms"};
+    static constexpr std::string_view CONFIG_MAX_COMPUTE_MS = {"max_compute_ms"};
+    static constexpr std::string_view CONFIG_WORKERS = {"workers"};
+    static constexpr std::string_view CONFIG_MIN_PARTICLES = {"min_particles"};
+    static constexpr std::string_view CONFIG_MAX_PARTICLES = {"max_particles"};
+    static constexpr std::string_view CONFIG_KLD_EPSILON = {"kld_epsilon"};
+    static constexpr std::string_view CONFIG_KLD_Z = {"kld_z"};
+    static constexpr std::string_view CONFIG_BIN_SIZE = {"bin_size"};
+    static constexpr std::string_view CONFIG_BIN_ANGLE = {"bin_angle"};
+    static constexpr std::string_view CONFIG_RESAMPLE_THRESHOLD = {"resample_threshold"};
+    static constexpr std::string_view CONFIG_UPDATE_MIN_DISTANCE = {"update_min_distance"};
+    static constexpr std::string_view CONFIG_UPDATE_MIN_ANGLE = {"update_min_angle"};
+    static constexpr std::string_view CONFIG_RANGE_SIGMA = {"range_sigma"};
+    static constexpr std::string_view CONFIG_Z_HIT = {"z_hit"};
+    static constexpr std::string_view CONFIG_Z_RAND = {"z_rand"};
+    static constexpr std::string_view CONFIG_ALPHA_ROT_ROT = {"alpha_rot_rot"};
+    static constexpr std::string_view CONFIG_ALPHA_ROT_TRANS = {"alpha_rot_trans"};
+    static constexpr std::string_view CONFIG_ALPHA_TRANS_TRANS = {"alpha_trans_trans"};
+    static constexpr std::string_view CONFIG_ALPHA_TRANS_ROT = {"alpha_trans_rot"};
+    static constexpr std::string_view CONFIG_INITIAL_X = {"initial_x"};
+    static constexpr std::string_view CONFIG_INITIAL_Y = {"initial_y"};
+    static constexpr std::string_view CONFIG_INITIAL_THETA = {"initial_theta"};
+    static constexpr std::string_view CONFIG_INITIAL_SIGMA_XY = {"initial_sigma_xy"};
+    static constexpr std::string_view CONFIG_INITIAL_SIGMA_THETA = {"initial_sigma_theta"};
+    static constexpr std::string_view CONFIG_CLUSTER_RADIUS = {"cluster_radius"};
+
+    bool enabled = true;
+    std::string map_file = "arena-map.json";
+    int period_ms = 100;                // localization cycle
+    int max_compute_ms = 30;            // particle count shrinks when an update takes longer
+    int workers = 0;                    // extra threads for the measurement update
+    int min_particles = 100;
+    int max_particles = 5000;
+    double kld_epsilon = 0.05;          // bound on the KL divergence of the sampled distribution
+    double kld_z = 2.326;               // standard normal quantile for 1 - delta (0.99)
+    double bin_size = 0.1;              // KLD histogram bin (m)
+    double bin_angle = 0.175;           // KLD histogram bin (rad)
+    double resample_threshold = 0.5;    // resample when the effective sample size falls below this fraction
+    double update_min_distance = 0.02;  // travel before a measurement update (m)
+    double update_min_angle = 0.05;     // rotation before a measurement update (rad)
+    double range_sigma = 0.05;          // IR range noise (m)
+    double z_hit = 0.9;                 // weight of the ray-cast model in the beam likelihood
+    double z_rand = 0.1;                // weight of uniform random readings
+    double alpha_rot_rot = 0.1;         // odometry noise, rotation from rotation
+    double alpha_rot_trans = 0.05;      // rotation from translation (rad/m)
+    double alpha_trans_trans = 0.1;     // translation from translation
+    double alpha_trans_rot = 0.02;      // translation from rotation (m/rad)
+    double initial_x = 0.0;             // start pose in the map frame
+    double initial_y = 0.0;
+    double initial_theta = 0.0;
+    double initial_sigma_xy = 0.1;
+    double initial_sigma_theta = 0.1;
+    double cluster_radius = 0.5;        // particles around the best one averaged into the pose (m)
+};
+
+MonteCarloLocalizerConfig tag_invoke( boost::json::value_to_tag< MonteCarloLocalizerConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
@@ -0,0 +1,413 @@
+#include <liblrn/monte-carlo-localizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <numbers>
+
+#include <boost/log/trivial.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace lrn {
+
+namespace {
+constexpr double infinity = std::numeric_limits<double>::infinity();
+constexpr double min_noise = 1e-6;          // normal_distribution needs a positive deviation
+constexpr double outside_log_weight = -50.0;
+}
+
+std::optional<ArenaMap> ArenaMap::load(const std::string& file) {
+    std::ifstream stream(file);
+    if(!stream) {
+        BOOST_LOG_TRIVIAL(error) << fmt::format("[localizer]: cannot open map '{}'", file);
+        return std::nullopt;
+    }
+    try {
+        const json j = json::parse(stream);
+        const auto rows = j.at("rows").get<std::vector<std::string>>();
+
+        ArenaMap map;
+        map.resolution_ = j.at("resolution").get<double>();
+        map.origin_ = {j.at("origin").at("x").get<double>(), j.at("origin").at("y").get<double>()};
+        map.height_ = static_cast<int>(rows.size());
+        for(const auto& row : rows) {
+            map.width_ = std::max(map.width_, static_cast<int>(row.size()));
+        }
+        if(!(map.resolution_ > 0.0) || map.width_ == 0 || map.height_ == 0) {
+            BOOST_LOG_TRIVIAL(error) << fmt::format("[localizer]: map '{}' is empty", file);
+            return std::nullopt;
+        }
+
+        // Rows are listed top first, stored bottom first; short rows are padded free
+        map.cells_.assign(static_cast<std::size_t>(map.width_) * static_cast<std::size_t>(map.height_), 0);
+        for(std::size_t r = 0; r < rows.size(); r++) {
+            const std::size_t y = rows.size() - 1 - r;
+            for(std::size_t x = 0; x < rows[r].size(); x++) {
+                map.cells_[y * static_cast<std::size_t>(map.width_) + x] = rows[r][x] == '#' ? 1 : 0;
+            }
+        }
+        BOOST_LOG_TRIVIAL(info) << fmt::format("[localizer]: loaded map '{}', {} x {} cells of {:.3f} m", file, map.width_, map.height_, map.resolution_);
+        return map;
+    } catch(const std::exception& e) {
+        BOOST_LOG_TRIVIAL(error) << fmt::format("[localizer]: failed to read map '{}': {}", file, e.what());
+        return std::nullopt;
+    }
+}
+
+bool ArenaMap::is_free(double x, double y) const {
+    return is_free(static_cast<int>(std::floor((x - origin_.x) / resolution_)), static_cast<int>(std::floor((y - origin_.y) / resolution_)));
+}
+
+Vec2 ArenaMap::cell_to_world(int x, int y) const {
+    return {origin_.x + (x + 0.5) * resolution_, origin_.y + (y + 0.5) * resolution_};
+}
+
+double ArenaMap::cast(double x, double y, double angle, double max_range) const {
+    // Grid traversal in cell units (Amanatides & Woo), visits every cell the ray crosses
+    const double gx = (x - origin_.x) / resolution_;
+    const double gy = (y - origin_.y) / resolution_;
+    int cx = static_cast<int>(std::floor(gx));
+    int cy = static_cast<int>(std::floor(gy));
+    if(!is_free(cx, cy)) {
+        return 0.0;
+    }
+
+    const double dx = std::cos(angle);
+    const double dy = std::sin(angle);
+    const int step_x = dx > 0.0 ? 1 : -1;
+    const int step_y = dy > 0.0 ? 1 : -1;
+    const double delta_x = std::abs(dx) < 1e-12 ? infinity : 1.0 / std::abs(dx);
+    const double delta_y = std::abs(dy) < 1e-12 ? infinity : 1.0 / std::abs(dy);
+    double next_x = std::abs(dx) < 1e-12 ? infinity : (dx > 0.0 ? cx + 1 - gx : gx - cx) * delta_x;
+    double next_y = std::abs(dy) < 1e-12 ? infinity : (dy > 0.0 ? cy + 1 - gy : gy - cy) * delta_y;
+    const double max_t = max_range / resolution_;
+
+    while(true) {
+        double t = 0.0;
+        if(next_x < next_y) {
+            t = next_x;
+            next_x += delta_x;
+            cx += step_x;
+        } else {
+            t = next_y;
+            next_y += delta_y;
+            cy += step_y;
+        }
+        if(t >= max_t) {
+            return max_range;
+        }
+        if(!is_free(cx, cy)) {
+            return t * resolution_;
+        }
+    }
+}
+
+MonteCarloLocalizer::MonteCarloLocalizer(MonteCarloLocalizerConfig& cfg)
+    : config(cfg)
+    , rng_(std::random_device{}())
+    , particle_cap_(static_cast<std::size_t>(std::max(cfg.max_particles, cfg.min_particles)))
+{
+    if(config.workers > 0) {
+        pool_ = std::make_unique<ThreadPool>(static_cast<std::size_t>(config.workers));
+    }
+}
+
+MonteCarloLocalizer::~MonteCarloLocalizer() {
+    stop();
+}
+
+bool MonteCarloLocalizer::start(Rover& rover) {
+    map_ = ArenaMap::load(config.map_file);
+    if(!map_) {
+        return false;
+    }
+    initialize();
+    publish(0.0);
+
+    should_stop_ = false;
+    localizer_thread_ = std::thread(&MonteCarloLocalizer::run, this, std::ref(rover));
+    return true;
+}
+
+void MonteCarloLocalizer::stop() {
+    should_stop_ = true;
+    if(localizer_thread_.joinable()) {
+        localizer_thread_.join();
+    }
+}
+
+void MonteCarloLocalizer::run(Rover& rover) {
+    const auto period = std::chrono::milliseconds(config.period_ms);
+    while(!should_stop_) {
+        const auto cycle_start = std::chrono::steady_clock::now();
+        cycle(rover);
+        std::this_thread::sleep_until(cycle_start + period);
+    }
+}
+
+void MonteCarloLocalizer::initialize() {
+    const auto n = static_cast<std::size_t>(std::max(config.max_particles, config.min_particles));
+    particles_.resize(n);
+    std::normal_distribution<double> noise_xy(0.0, std::max(config.initial_sigma_xy, min_noise));
+    std::normal_distribution<double> noise_theta(0.0, std::max(config.initial_sigma_theta, min_noise));
+    for(std::size_t i = 0; i < n; i++) {
+        particles_.x[i] = config.initial_x + noise_xy(rng_);
+        particles_.y[i] = config.initial_y + noise_xy(rng_);
+        particles_.theta[i] = wrap_angle(config.initial_theta + noise_theta(rng_));
+        particles_.weight[i] = 1.0 / static_cast<double>(n);
+    }
+    if(!map_->is_free(config.initial_x, config.initial_y)) {
+        BOOST_LOG_TRIVIAL(warning) << fmt::format("[localizer]: initial pose ({:.2f}, {:.2f}) is not in free space", config.initial_x, config.initial_y);
+    }
+    last_odometry_.reset();
+}
+
+void MonteCarloLocalizer::move(const RobotState& from, const RobotState& to) {
+    // Odometry motion model: rotate, translate, rotate, each with its own noise
+    const double dx = to.pos.x - from.pos.x;
+    const double dy = to.pos.y - from.pos.y;
+    double trans = std::hypot(dx, dy);
+    double rot1 = trans < 1e-4 ? 0.0 : wrap_angle(std::atan2(dy, dx) - from.theta);
+    if(std::abs(rot1) > std::numbers::pi / 2.0) {
+        // Reversing
+        rot1 = wrap_angle(rot1 - std::numbers::pi);
+        trans = -trans;
+    }
+    const double rot2 = wrap_angle(to.theta - from.theta - rot1);
+
+    const double abs_trans = std::abs(trans);
+    std::normal_distribution<double> noise_rot1(0.0, std::max(config.alpha_rot_rot * std::abs(rot1) + config.alpha_rot_trans * abs_trans, min_noise));
+    std::normal_distribution<double> noise_trans(0.0, std::max(config.alpha_trans_trans * abs_trans + config.alpha_trans_rot * (std::abs(rot1) + std::abs(rot2)), min_noise));
+    std::normal_distribution<double> noise_rot2(0.0, std::max(config.alpha_rot_rot * std::abs(rot2) + config.alpha_rot_trans * abs_trans, min_noise));
+
+    for(std::size_t i = 0; i < particles_.size(); i++) {
+        const double r1 = rot1 + noise_rot1(rng_);
+        const double t = trans + noise_trans(rng_);
+        const double r2 = rot2 + noise_rot2(rng_);
+        const double heading = particles_.theta[i] + r1;
+        particles_.x[i] += t * std::cos(heading);
+        particles_.y[i] += t * std::sin(heading);
+        particles_.theta[i] = wrap_angle(heading + r2);
+    }
+}
+
+void MonteCarloLocalizer::weigh(const SensorReading& sensors) {
+    std::array<double, ir_sensors_count> offsets {};
+    std::array<double, ir_sensors_count> ranges {};
+    std::size_t beams = 0;
+    for(std::size_t i = 0; i < ir_sensors_count; i++) {
+        if(sensors.ir[i]) {
+            offsets[beams] = ir_sensors_theta_start - static_cast<double>(i) * ir_sensors_delta;
+            ranges[beams] = std::clamp(*sensors.ir[i], 0.0, ir_max_range);
+            beams++;
+        }
+    }
+    if(beams == 0) {
+        return;
+    }
+
+    const std::size_t n = particles_.size();
+    log_weight_.resize(n);
+    const double inv_var = 1.0 / (config.range_sigma * config.range_sigma);
+    const double rand_floor = config.z_rand / ir_max_range;
+    const ArenaMap& map = *map_;
+
+    ThreadPool::RangeFunction update = [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; i++) {
+            const double x = particles_.x[i];
+            const double y = particles_.y[i];
+            if(!map.is_free(x, y)) {
+                log_weight_[i] = outside_log_weight * static_cast<double>(beams);
+                continue;
+            }
+            double lw = 0.0;
+            for(std::size_t b = 0; b < beams; b++) {
+                const double expected = map.cast(x, y, particles_.theta[i] + offsets[b], ir_max_range);
+                const double e = ranges[b] - expected;
+                lw += std::log(config.z_hit * std::exp(-0.5 * e * e * inv_var) + rand_floor);
+            }
+            log_weight_[i] = lw;
+        }
+    };
+    if(pool_) {
+        pool_->parallel_for(n, 64, update);
+    } else {
+        update(0, n);
+    }
+
+    // Normalise in the log domain, the likelihoods of three beams underflow quickly
+    double max_lw = -infinity;
+    for(std::size_t i = 0; i < n; i++) {
+        log_weight_[i] += std::log(std::max(particles_.weight[i], std::numeric_limits<double>::min()));
+        max_lw = std::max(max_lw, log_weight_[i]);
+    }
+    double sum = 0.0;
+    for(std::size_t i = 0; i < n; i++) {
+        particles_.weight[i] = std::exp(log_weight_[i] - max_lw);
+        sum += particles_.weight[i];
+    }
+    for(auto& w : particles_.weight) {
+        w /= sum;
+    }
+}
+
+std::size_t MonteCarloLocalizer::kld_bound(std::size_t bins) const {
+    // Samples needed so the KL divergence to the true posterior stays below
+    // epsilon with probability 1 - delta, Wilson-Hilferty approximation
+    if(bins <= 1) {
+        return static_cast<std::size_t>(config.min_particles);
+    }
+    const double k = static_cast<double>(bins - 1);
+    const double a = 2.0 / (9.0 * k);
+    const double c = 1.0 - a + std::sqrt(a) * config.kld_z;
+    return static_cast<std::size_t>(std::ceil(k / (2.0 * config.kld_epsilon) * c * c * c));
+}
+
+void MonteCarloLocalizer::resample() {
+    const std::size_t n = particles_.size();
+    cumulative_.resize(n);
+    double total = 0.0;
+    for(std::size_t i = 0; i < n; i++) {
+        total += particles_.weight[i];
+        cumulative_[i] = total;
+    }
+
+    // KLD sampling: keep drawing until the bound for the bins occupied so far is reached
+    const auto min_particles = static_cast<std::size_t>(std::max(config.min_particles, 1));
+    const double inv_bin = 1.0 / config.bin_size;
+    const double inv_bin_angle = 1.0 / config.bin_angle;
+    std::uniform_real_distribution<double> draw(0.0, total);
+    bins_.clear();
+    resampled_.resize(particle_cap_);
+    std::size_t count = 0;
+    std::size_t bound = min_particles;
+    while(count < particle_cap_ && (count < min_particles || count < bound)) {
+        const auto it = std::upper_bound(cumulative_.begin(), cumulative_.end(), draw(rng_));
+        const auto i = static_cast<std::size_t>(std::min<std::ptrdiff_t>(it - cumulative_.begin(), static_cast<std::ptrdiff_t>(n - 1)));
+        resampled_.x[count] = particles_.x[i];
+        resampled_.y[count] = particles_.y[i];
+        resampled_.theta[count] = particles_.theta[i];
+        count++;
+
+        const auto bx = static_cast<std::uint64_t>(static_cast<std::int64_t>(std::floor(particles_.x[i] * inv_bin)) & 0xFFFFFF);
+        const auto by = static_cast<std::uint64_t>(static_cast<std::int64_t>(std::floor(particles_.y[i] * inv_bin)) & 0xFFFFFF);
+        const auto bt = static_cast<std::uint64_t>(static_cast<std::int64_t>(std::floor(particles_.theta[i] * inv_bin_angle)) & 0xFFFF);
+        if(bins_.insert((bx << 40) | (by << 16) | bt).second) {
+            bound = std::max(min_particles, kld_bound(bins_.size()));
+        }
+    }
+
+    resampled_.resize(count);
+    std::fill(resampled_.weight.begin(), resampled_.weight.end(), 1.0 / static_cast<double>(count));
+    std::swap(particles_, resampled_);
+}
+
+void MonteCarloLocalizer::publish(double update_us) {
+    const std::size_t n = particles_.size();
+    const auto best = static_cast<std::size_t>(std::max_element(particles_.weight.begin(), particles_.weight.end()) - particles_.weight.begin());
+    const double bx = particles_.x[best];
+    const double by = particles_.y[best];
+    const double radius_sq = config.cluster_radius * config.cluster_radius;
+
+    // Weighted mean of the cluster around the best particle, a multimodal cloud has no useful overall mean
+    double sw = 0.0;
+    double sx = 0.0;
+    double sy = 0.0;
+    double ss = 0.0;
+    double sc = 0.0;
+    for(std::size_t i = 0; i < n; i++) {
+        const double dx = particles_.x[i] - bx;
+        const double dy = particles_.y[i] - by;
+        if(dx * dx + dy * dy > radius_sq) {
+            continue;
+        }
+        const double w = particles_.weight[i];
+        sw += w;
+        sx += w * particles_.x[i];
+        sy += w * particles_.y[i];
+        ss += w * std::sin(particles_.theta[i]);
+        sc += w * std::cos(particles_.theta[i]);
+    }
+
+    LocalizationEstimate estimate;
+    estimate.state.pos = {sx / sw, sy / sw};
+    estimate.state.theta = std::atan2(ss, sc);
+    double var = 0.0;
+    for(std::size_t i = 0; i < n; i++) {
+        const double dx = particles_.x[i] - estimate.state.pos.x;
+        const double dy = particles_.y[i] - estimate.state.pos.y;
+        var += particles_.weight[i] * (dx * dx + dy * dy);
+    }
+    estimate.position_std = std::sqrt(var);
+    const double resultant = std::hypot(ss, sc) / sw;
+    estimate.heading_std = std::sqrt(-2.0 * std::log(std::clamp(resultant, 1e-12, 1.0)));
+    estimate.particles = n;
+    estimate.updates = updates_;
+    estimate.last_update_us = update_us;
+    if(last_odometry_) {
+        estimate.state.attitude = last_odometry_->attitude;
+    }
+    estimate_.store(estimate);
+}
+
+void MonteCarloLocalizer::cycle(Rover& rover) {
+    const auto sensors = rover.readSensors();
+    const auto odometry = rover.getStateAt(sensors.stamp).value_or(rover.getState());
+    if(!last_odometry_) {
+        last_odometry_ = odometry;
+        last_stamp_ = sensors.stamp;
+        return;
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    move(*last_odometry_, odometry);
+
+    // Weigh only after some motion, a stationary rover would just repeat the
+    // same readings and collapse the cloud onto noise
+    travelled_ += std::hypot(odometry.pos.x - last_odometry_->pos.x, odometry.pos.y - last_odometry_->pos.y);
+    rotated_ += std::abs(wrap_angle(odometry.theta - last_odometry_->theta));
+    last_odometry_ = odometry;
+
+    const bool updated = sensors.stamp != last_stamp_
+        && (travelled_ >= config.update_min_distance || rotated_ >= config.update_min_angle);
+    if(updated) {
+        last_stamp_ = sensors.stamp;
+        travelled_ = 0.0;
+        rotated_ = 0.0;
+        weigh(sensors);
+        updates_++;
+
+        double sum_sq = 0.0;
+        for(const double w : particles_.weight) {
+            sum_sq += w * w;
+        }
+        const double effective = 1.0 / sum_sq;
+        if(effective < config.resample_threshold * static_cast<double>(particles_.size())) {
+            resample();
+        }
+    }
+    const double elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+    // Trade accuracy for time when the update overruns its budget
+    const auto max_particles = static_cast<std::size_t>(std::max(config.max_particles, config.min_particles));
+    const auto min_particles = static_cast<std::size_t>(std::max(config.min_particles, 1));
+    if(elapsed_us > config.max_compute_ms * 1000.0) {
+        particle_cap_ = std::max(min_particles, particle_cap_ * 4 / 5);
+        BOOST_LOG_TRIVIAL(warning) << fmt::format("[localizer]: update took {:.0f} us for {} particles, limit lowered to {}", elapsed_us, particles_.size(), particle_cap_);
+    } else if(particle_cap_ < max_particles && elapsed_us < config.max_compute_ms * 500.0) {
+        particle_cap_ = std::min(max_particles, particle_cap_ + particle_cap_ / 10 + 1);
+    }
+
+    publish(elapsed_us);
+    if(updated && updates_ % 50 == 0) {
+        const auto estimate = estimate_.load();
+        BOOST_LOG_TRIVIAL(debug) << fmt::format("[localizer]: ({:.2f}, {:.2f}, {:.2f}) +-{:.2f} m, {} particles, {:.0f} us",
+            estimate.state.pos.x, estimate.state.pos.y, estimate.state.theta, estimate.position_std, estimate.particles, elapsed_us);
+    }
+}
+
+} // namespace lrn
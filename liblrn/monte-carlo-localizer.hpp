@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <liblrn/rover.hpp>
+#include <liblrn/seqlock.hpp>
+#include <liblrn/thread-pool.hpp>
+#include <liblrn/monte-carlo-localizer-config.hpp>
+
+namespace lrn {
+
+/**
+ * @brief Static occupancy map of a known arena.
+ *
+ * Loaded from a JSON file with the cell size, the map-frame position of the
+ * lower-left corner and one string per row, top row first, where '#' marks an
+ * occupied cell:
+ *
+ *     {"resolution": 0.05, "origin": {"x": -1.0, "y": -1.0}, "rows": ["####", "#..#", "####"]}
+ */
+class ArenaMap {
+public:
+    static std::optional<ArenaMap> load(const std::string& file);
+
+    double resolution() const { return resolution_; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    bool is_free(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width_ && y < height_
+            && cells_[static_cast<std::size_t>(y) * static_cast<std::size_t>(width_) + static_cast<std::size_t>(x)] == 0;
+    }
+    bool is_free(double x, double y) const;
+
+    /**
+     * @brief Distance along the ray to the first occupied cell or the map edge, at most max_range.
+     */
+    double cast(double x, double y, double angle, double max_range) const;
+
+    Vec2 cell_to_world(int x, int y) const;
+
+private:
+    double resolution_ = 0.05;
+    Vec2 origin_ {0.0, 0.0};
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<std::uint8_t> cells_;     // row-major, row 0 at the bottom
+};
+
+struct LocalizationEstimate {
+    RobotState state {};            // map frame
+    double position_std = 0.0;      // spread of the particles around the pose (m)
+    double heading_std = 0.0;       // (rad)
+    std::size_t particles = 0;
+    std::uint64_t updates = 0;
+    double last_update_us = 0.0;
+};
+
+/**
+ * @brief Monte Carlo localization on a known arena map.
+ *
+ * Particles are moved with the odometry increments of the rover's dead
+ * reckoning and weighted by comparing the measured IR ranges with ranges
+ * ray-cast on the map. The measurement update is split across a thread pool.
+ * Resampling draws particles until the KLD bound for the number of occupied
+ * pose bins is met, so a converged filter runs with few particles; the upper
+ * limit shrinks when an update overruns max_compute_ms.
+ */
+class MonteCarloLocalizer {
+public:
+    explicit MonteCarloLocalizer(MonteCarloLocalizerConfig& cfg);
+    ~MonteCarloLocalizer();
+
+    MonteCarloLocalizer(const MonteCarloLocalizer&) = delete;
+    MonteCarloLocalizer& operator=(const MonteCarloLocalizer&) = delete;
+
+    /**
+     * @brief Loads the map and starts the filter thread, false when the map cannot be loaded.
+     */
+    bool start(Rover& rover);
+    void stop();
+
+    /**
+     * @brief Best pose in the map frame, lock-free.
+     */
+    RobotState getState() const { return estimate_.load().state; }
+    LocalizationEstimate getEstimate() const { return estimate_.load(); }
+
+private:
+    struct Particles {
+        std::vector<double> x, y, theta, weight;
+
+        std::size_t size() const { return x.size(); }
+        void resize(std::size_t n) {
+            x.resize(n);
+            y.resize(n);
+            theta.resize(n);
+            weight.resize(n);
+        }
+    };
+
+    void run(Rover& rover);
+    void cycle(Rover& rover);
+
+    void initialize();
+    void move(const RobotState& from, const RobotState& to);
+    void weigh(const SensorReading& sensors);
+    void resample();
+    void publish(double update_us);
+
+    std::size_t kld_bound(std::size_t bins) const;
+
+    MonteCarloLocalizerConfig& config;
+    std::optional<ArenaMap> map_;
+    std::unique_ptr<ThreadPool> pool_;
+    std::mt19937 rng_;
+
+    Particles particles_;
+    Particles resampled_;
+    std::vector<double> log_weight_;
+    std::vector<double> cumulative_;
+    std::unordered_set<std::uint64_t> bins_;
+    std::size_t particle_cap_;
+
+    std::optional<RobotState> last_odometry_;     // odometry the particles were last moved to
+    std::chrono::steady_clock::time_point last_stamp_;    // IR sample used by the last measurement update
+    double travelled_ = 0.0;                            // odometry since the last measurement update
+    double rotated_ = 0.0;
+    std::uint64_t updates_ = 0;
+
+    SeqLock<LocalizationEstimate> estimate_;
+
+    std::atomic<bool> should_stop_ {false};
+    std::thread localizer_thread_;
+};
+
+} // namespace lrn
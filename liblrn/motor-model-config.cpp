@@ -0,0 +1,66 @@
+#include <liblrn/motor-model-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <stdexcept>
+#include <string_view>
+
+namespace lrn {
+
+bool is_monotone(const MotorTableConfig& table) {
+    if(table.omega.size() != table.duty.size() || table.omega.size() < 2) {
+        return false;
+    }
+    for(std::size_t i = 1; i < table.omega.size(); i++) {
+        if(!(table.omega[i] > table.omega[i - 1]) || table.duty[i] < table.duty[i - 1]) {
+            return false;
+        }
+    }
+    return table.omega.front() >= 0.0 && table.duty.front() >= 0.0;
+}
+
+MotorTableConfig tag_invoke( boost::json::value_to_tag< MotorTableConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    MotorTableConfig config;
+    extract( obj, config.omega, MotorTableConfig::CONFIG_OMEGA);
+    extract( obj, config.duty, MotorTableConfig::CONFIG_DUTY);
+
+    if(!is_monotone(config)) {
+        throw std::invalid_argument("Motor table must pair increasing omega with non-decreasing duty values");
+    }
+
+    return config;
+}
+
+MotorCalibrationConfig tag_invoke( boost::json::value_to_tag< MotorCalibrationConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    MotorCalibrationConfig config;
+    extract_optional( obj, config.duty_min, MotorCalibrationConfig::CONFIG_DUTY_MIN);
+    extract_optional( obj, config.duty_max, MotorCalibrationConfig::CONFIG_DUTY_MAX);
+    extract_optional( obj, config.duty_step, MotorCalibrationConfig::CONFIG_DUTY_STEP);
+    extract_optional( obj, config.still_ms, MotorCalibrationConfig::CONFIG_STILL_MS);
+    extract_optional( obj, config.settle_ms, MotorCalibrationConfig::CONFIG_SETTLE_MS);
+    extract_optional( obj, config.measure_ms, MotorCalibrationConfig::CONFIG_MEASURE_MS);
+    extract_optional( obj, config.sample_period_ms, MotorCalibrationConfig::CONFIG_SAMPLE_PERIOD_MS);
+    extract_optional( obj, config.min_rate, MotorCalibrationConfig::CONFIG_MIN_RATE);
+
+    return config;
+}
+
+MotorModelConfig tag_invoke( boost::json::value_to_tag< MotorModelConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    MotorModelConfig config;
+    extract_optional( obj, config.file, MotorModelConfig::CONFIG_FILE);
+    extract_optional( obj, config.left, MotorModelConfig::CONFIG_LEFT);
+    extract_optional( obj, config.right, MotorModelConfig::CONFIG_RIGHT);
+    extract_optional( obj, config.calibration, MotorModelConfig::CONFIG_CALIBRATION);
+
+    return config;
+}
+
+} // namespace lrn
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <boost/json.hpp>
+
+namespace lrn {
+
+class MotorTableConfig
+{
+public:
+    static constexpr std::string_view CONFIG_OMEGA = {"omega"};
+    static constexpr std::string_view CONFIG_DUTY = {"duty"};
+
+    // Steady wheel speed reached at each duty, increasing; the first entry is
+    // the end of the dead band, the last one the saturation speed
+    std::vector<double> omega {4.32, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 10.5, 11.0, 11.5, 11.84};    // rad/s
+    std::vector<double> duty {38.0, 46.0, 55.0, 69.0, 88.0, 111.0, 139.0, 159.0, 186.0, 224.0, 255.0};
+};
+
+class MotorCalibrationConfig
+{
+public:
+    static constexpr std::string_view CONFIG_DUTY_MIN = {"duty_min"};
+    static constexpr std::string_view CONFIG_DUTY_MAX = {"duty_max"};
+    static constexpr std::string_view CONFIG_DUTY_STEP = {"duty_step"};
+    static constexpr std::string_view CONFIG_STILL_MS = {"still_ms"};
+    static constexpr std::string_view CONFIG_SETTLE_MS = {"settle_ms"};
+    static constexpr std::string_view CONFIG_MEASURE_MS = {"measure_ms"};
+    static constexpr std::string_view CONFIG_SAMPLE_PERIOD_MS = {"sample_period_ms"};
+    static constexpr std::string_view CONFIG_MIN_RATE = {"min_rate"};
+
+    int duty_min = 20;
+    int duty_max = 255;
+    int duty_step = 15;
+    int still_ms = 5000;            // wheels stopped at start, lets the gyro bias settle
+    int settle_ms = 800;            // after each duty step, before measuring
+    int measure_ms = 1000;          // yaw rate averaging window
+    int sample_period_ms = 20;      // sensor period requested from the MCU while calibrating
+    double min_rate = 0.05;         // yaw rates below it count as not moving (rad/s)
+};
+
+class MotorModelConfig
+{
+public:
+    static constexpr std::string_view CONFIG_FILE = {"file"};
+    static constexpr std::string_view CONFIG_LEFT = {"left"};
+    static constexpr std::string_view CONFIG_RIGHT = {"right"};
+    static constexpr std::string_view CONFIG_CALIBRATION = {"calibration"};
+
+    std::string file {"motor-model.json"};  // calibrated tables, override left/right when present; empty to disable
+    MotorTableConfig left;
+    MotorTableConfig right;
+    MotorCalibrationConfig calibration;
+};
+
+/**
+ * @brief True when the table has matching sizes, at least two points, strictly increasing speeds and non-decreasing duties.
+ */
+bool is_monotone(const MotorTableConfig& table);
+
+MotorTableConfig tag_invoke( boost::json::value_to_tag< MotorTableConfig > /*unused*/, boost::json::value const& json_value );
+MotorCalibrationConfig tag_invoke( boost::json::value_to_tag< MotorCalibrationConfig > /*unused*/, boost::json::value const& json_value );
+MotorModelConfig tag_invoke( boost::json::value_to_tag< MotorModelConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
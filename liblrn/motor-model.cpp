@@ -0,0 +1,162 @@
+#include <liblrn/motor-model.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include <boost/log/trivial.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace lrn {
+
+WheelMotorModel::WheelMotorModel(const MotorTableConfig& table)
+    : table_(table)
+    , dead_band_(table.omega.front())
+    , max_speed_(table.omega.back())
+    , max_duty_(table.duty.back())
+    , inv_step_(static_cast<double>(grid_segments) / (table.omega.back() - table.omega.front()))
+{
+    std::size_t k = 0;
+    for(std::size_t i = 0; i <= grid_segments; i++) {
+        const double omega = dead_band_ + static_cast<double>(i) / inv_step_;
+        while(k + 2 < table_.omega.size() && omega > table_.omega[k + 1]) {
+            k++;
+        }
+        const double t = std::clamp((omega - table_.omega[k]) / (table_.omega[k + 1] - table_.omega[k]), 0.0, 1.0);
+        grid_[i] = table_.duty[k] + t * (table_.duty[k + 1] - table_.duty[k]);
+    }
+}
+
+double WheelMotorModel::speed(double duty) const {
+    const double a = duty < 0.0 ? -duty : duty;
+    if(a < table_.duty.front()) {
+        return 0.0;
+    }
+    // Flat runs of duty resolve to their lowest speed
+    const auto it = std::lower_bound(table_.duty.begin(), table_.duty.end(), a);
+    double s = max_speed_;
+    if(it != table_.duty.end()) {
+        const auto k = static_cast<std::size_t>(it - table_.duty.begin());
+        if(k == 0 || !(*it > a)) {
+            s = table_.omega[k];
+        } else {
+            const double t = (a - table_.duty[k - 1]) / (table_.duty[k] - table_.duty[k - 1]);
+            s = table_.omega[k - 1] + t * (table_.omega[k] - table_.omega[k - 1]);
+        }
+    }
+    return duty < 0.0 ? -s : s;
+}
+
+std::optional<MotorTableConfig> fit_motor_table(std::vector<std::pair<double, double>> samples, double min_speed) {
+    std::sort(samples.begin(), samples.end());
+
+    // Pool adjacent violators: merge blocks until the speeds do not decrease
+    struct Block {
+        double sum;
+        std::size_t count;
+        std::size_t end;
+        double mean() const { return sum / static_cast<double>(count); }
+    };
+    std::vector<Block> blocks;
+    for(std::size_t i = 0; i < samples.size(); i++) {
+        blocks.push_back({samples[i].second, 1, i + 1});
+        while(blocks.size() > 1 && blocks[blocks.size() - 2].mean() > blocks.back().mean()) {
+            const Block last = blocks.back();
+            blocks.pop_back();
+            blocks.back().sum += last.sum;
+            blocks.back().count += last.count;
+            blocks.back().end = last.end;
+        }
+    }
+
+    MotorTableConfig table;
+    table.omega.clear();
+    table.duty.clear();
+    std::size_t begin = 0;
+    for(const auto& block : blocks) {
+        const double omega = block.mean();
+        if(omega >= min_speed && (table.omega.empty() || omega > table.omega.back())) {
+            table.omega.push_back(omega);
+            table.duty.push_back(samples[begin].first);
+        }
+        begin = block.end;
+    }
+    if(!is_monotone(table)) {
+        return std::nullopt;
+    }
+    return table;
+}
+
+MotorModel::MotorModel(const MotorModelConfig& cfg)
+    : config(cfg)
+{}
+
+void MotorModel::load() {
+    left_ = WheelMotorModel(config.left);
+    right_ = WheelMotorModel(config.right);
+
+    if(config.file.empty()) {
+        return;
+    }
+    std::ifstream file(config.file);
+    if(!file) {
+        BOOST_LOG_TRIVIAL(info) << fmt::format("[motors]: no calibration in '{}', using the configured tables", config.file);
+        return;
+    }
+    try {
+        const json j = json::parse(file);
+        MotorTableConfig left;
+        MotorTableConfig right;
+        left.omega = j.at("left").at("omega").get<std::vector<double>>();
+        left.duty = j.at("left").at("duty").get<std::vector<double>>();
+        right.omega = j.at("right").at("omega").get<std::vector<double>>();
+        right.duty = j.at("right").at("duty").get<std::vector<double>>();
+        if(!is_monotone(left) || !is_monotone(right)) {
+            BOOST_LOG_TRIVIAL(warning) << fmt::format("[motors]: ignoring non-monotone calibration in '{}'", config.file);
+            return;
+        }
+        left_ = WheelMotorModel(left);
+        right_ = WheelMotorModel(right);
+        BOOST_LOG_TRIVIAL(info) << fmt::format("[motors]: loaded calibration, dead band {:.2f}/{:.2f} rad/s, max {:.2f}/{:.2f} rad/s",
+            left_.dead_band(), right_.dead_band(), left_.max_speed(), right_.max_speed());
+    } catch(const std::exception& e) {
+        BOOST_LOG_TRIVIAL(warning) << fmt::format("[motors]: failed to read '{}': {}", config.file, e.what());
+    }
+}
+
+void MotorModel::update(const MotorTableConfig& left, const MotorTableConfig& right) {
+    left_ = WheelMotorModel(left);
+    right_ = WheelMotorModel(right);
+    save();
+}
+
+void MotorModel::save() const {
+    if(config.file.empty()) {
+        return;
+    }
+
+    // Write aside and rename, a crash never leaves a truncated file behind
+    const std::string tmp = config.file + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::trunc);
+        if(!file) {
+            BOOST_LOG_TRIVIAL(warning) << fmt::format("[motors]: cannot write '{}'", tmp);
+            return;
+        }
+        const json j = {
+            {"left", {{"omega", left_.table().omega}, {"duty", left_.table().duty}}},
+            {"right", {{"omega", right_.table().omega}, {"duty", right_.table().duty}}}
+        };
+        file << j.dump(2);
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, config.file, ec);
+    if(ec) {
+        BOOST_LOG_TRIVIAL(warning) << fmt::format("[motors]: cannot replace '{}': {}", config.file, ec.message());
+    }
+}
+
+} // namespace lrn
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <liblrn/motor-model-config.hpp>
+
+namespace lrn {
+
+/**
+ * @brief Inverse model of one wheel motor, wheel speed to PWM duty.
+ *
+ * Piecewise linear through a monotone calibration table. The table is
+ * resampled on a uniform speed grid at construction, so a lookup is one
+ * multiply and one linear interpolation. Speeds below the first table entry
+ * are in the dead band and map to zero duty; speeds beyond the last entry
+ * saturate. Negative speeds mirror positive ones.
+ */
+class WheelMotorModel {
+public:
+    WheelMotorModel() : WheelMotorModel(MotorTableConfig{}) {}
+
+    /**
+     * @param table must satisfy is_monotone()
+     */
+    explicit WheelMotorModel(const MotorTableConfig& table);
+
+    double duty(double omega) const {
+        const double a = omega < 0.0 ? -omega : omega;
+        if(a < dead_band_) {
+            return 0.0;
+        }
+        double d = max_duty_;
+        if(a < max_speed_) {
+            const double x = (a - dead_band_) * inv_step_;
+            // x can round up to grid_segments just below max_speed_
+            const auto i = std::min(static_cast<std::size_t>(x), grid_segments - 1);
+            d = grid_[i] + (x - static_cast<double>(i)) * (grid_[i + 1] - grid_[i]);
+        }
+        return omega < 0.0 ? -d : d;
+    }
+
+    /**
+     * @brief Steady speed expected for a duty, the inverse of duty().
+     */
+    double speed(double duty) const;
+
+    double dead_band() const { return dead_band_; }
+    double max_speed() const { return max_speed_; }
+    const MotorTableConfig& table() const { return table_; }
+
+private:
+    static constexpr std::size_t grid_segments = 128;
+
+    MotorTableConfig table_;
+    double dead_band_;
+    double max_speed_;
+    double max_duty_;
+    double inv_step_;
+    std::array<double, grid_segments + 1> grid_ {};     // duty at uniformly spaced speeds
+};
+
+/**
+ * @brief Fits a monotone table to (duty, measured wheel speed) samples.
+ *
+ * The speeds are made non-decreasing in duty (pool adjacent violators), the
+ * samples below min_speed are dropped as dead band and flat runs keep their
+ * lowest duty. Empty when fewer than two usable points remain.
+ */
+std::optional<MotorTableConfig> fit_motor_table(std::vector<std::pair<double, double>> samples, double min_speed);
+
+/**
+ * @brief Left and right wheel models, from the configuration or the calibration file.
+ *
+ * Loaded before driving; the models are not replaced while the wheels are commanded.
+ */
+class MotorModel {
+public:
+    explicit MotorModel(const MotorModelConfig& cfg);
+
+    void load();
+
+    /**
+     * @brief Replaces both tables and stores them in the calibration file.
+     */
+    void update(const MotorTableConfig& left, const MotorTableConfig& right);
+
+    const WheelMotorModel& left() const { return left_; }
+    const WheelMotorModel& right() const { return right_; }
+
+private:
+    void save() const;
+
+    const MotorModelConfig& config;
+    WheelMotorModel left_;
+    WheelMotorModel right_;
+};
+
+} // namespace lrn
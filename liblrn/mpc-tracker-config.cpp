@@ -0,0 +1,29 @@
+#include <liblrn/mpc-tracker-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <string_view>
+
+namespace lrn {
+
+MpcTrackerConfig tag_invoke( boost::json::value_to_tag< MpcTrackerConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    MpcTrackerConfig config;
+    extract_optional( obj, config.enabled, MpcTrackerConfig::CONFIG_ENABLED);
+    extract_optional( obj, config.HORIZON, MpcTrackerConfig::CONFIG_HORIZON);
+    extract_optional( obj, config.DT, MpcTrackerConfig::CONFIG_DT);
+    extract_optional( obj, config.MAX_ITERATIONS, MpcTrackerConfig::CONFIG_MAX_ITERATIONS);
+    extract_optional( obj, config.Q_POS, MpcTrackerConfig::CONFIG_Q_POS);
+    extract_optional( obj, config.Q_THETA, MpcTrackerConfig::CONFIG_Q_THETA);
+    extract_optional( obj, config.R_U, MpcTrackerConfig::CONFIG_R_U);
+    extract_optional( obj, config.R_DU, MpcTrackerConfig::CONFIG_R_DU);
+    extract_optional( obj, config.STEP, MpcTrackerConfig::CONFIG_STEP);
+    extract_optional( obj, config.TOLERANCE, MpcTrackerConfig::CONFIG_TOLERANCE);
+
+    return config;
+}
+
+} // namespace lrn
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <string_view>
+
+namespace lrn {
+
+class MpcTrackerConfig
+{
+public:
+    static constexpr std::string_view CONFIG_ENABLED = {"enabled"};
+    static constexpr std::string_view CONFIG_HORIZON = {"HORIZON"};
+    static constexpr std::string_view CONFIG_DT = {"DT"};
+    static constexpr std::string_view CONFIG_MAX_ITERATIONS = {"MAX_ITERATIONS"};
+    static constexpr std::string_view CONFIG_Q_POS = {"Q_POS"};
+    static constexpr std::string_view CONFIG_Q_THETA = {"Q_THETA"};
+    static constexpr std::string_view CONFIG_R_U = {"R_U"};
+    static constexpr std::string_view CONFIG_R_DU = {"R_DU"};
+    static constexpr std::string_view CONFIG_STEP = {"STEP"};
+    static constexpr std::string_view CONFIG_TOLERANCE = {"TOLERANCE"};
+
+    bool enabled = true;
+    int HORIZON = 10;           // prediction steps
+    double DT = 0.1;            // prediction step (s)
+    int MAX_ITERATIONS = 30;
+    double Q_POS = 10.0;        // position tracking weight
+    double Q_THETA = 1.0;       // heading tracking weight
+    double R_U = 1e-4;          // wheel speed effort weight
+    double R_DU = 1e-3;         // wheel speed change weight
+    double STEP = 0.5;          // initial gradient step
+    double TOLERANCE = 1e-6;    // relative cost decrease to stop iterating
+};
+
+MpcTrackerConfig tag_invoke( boost::json::value_to_tag< MpcTrackerConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
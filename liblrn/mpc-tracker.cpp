@@ -0,0 +1,173 @@
+#include <liblrn/mpc-tracker.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+#include <boost/log/trivial.hpp>
+#include <fmt/format.h>
+
+namespace lrn {
+
+MpcTracker::MpcTracker(const RoverConfig& rover_cfg, MpcTrackerConfig& cfg)
+    : config(cfg)
+    , r_(rover_cfg.wheel_radius)
+    , wheelbase_(rover_cfg.wheelbase)
+    , max_wheel_speed_(rover_cfg.max_wheel_speed)
+    , max_wheel_step_(rover_cfg.max_wheel_acceleration * cfg.DT)
+    , u_(static_cast<std::size_t>(std::max(cfg.HORIZON, 1)), WheelCommand{0.0, 0.0})
+    , candidate_(u_.size())
+    , grad_(u_.size())
+    , states_(u_.size() + 1)
+    , step_(cfg.STEP)
+{}
+
+void MpcTracker::reset() {
+    std::fill(u_.begin(), u_.end(), WheelCommand{0.0, 0.0});
+    applied_ = {0.0, 0.0};
+    step_ = config.STEP;
+}
+
+void MpcTracker::project(std::vector<WheelCommand>& u) const {
+    // Acceleration limit relative to the previous step, then the speed limit
+    WheelCommand prev = applied_;
+    for(auto& uk : u) {
+        uk.wl = std::clamp(std::clamp(uk.wl, prev.wl - max_wheel_step_, prev.wl + max_wheel_step_), -max_wheel_speed_, max_wheel_speed_);
+        uk.wr = std::clamp(std::clamp(uk.wr, prev.wr - max_wheel_step_, prev.wr + max_wheel_step_), -max_wheel_speed_, max_wheel_speed_);
+        prev = uk;
+    }
+}
+
+double MpcTracker::rollout_cost(const RobotState& state, const TrackingReference& reference, const std::vector<WheelCommand>& u) {
+    const double dt = config.DT;
+    double cost = 0.0;
+    WheelCommand prev = applied_;
+    states_[0] = state;
+    for(std::size_t k = 0; k < u.size(); k++) {
+        const RobotState& s = states_[k];
+        const double v = r_ * (u[k].wr + u[k].wl) / 2.0;
+        const double w = r_ * (u[k].wr - u[k].wl) / wheelbase_;
+        RobotState& next = states_[k + 1];
+        next = s;
+        next.pos = {s.pos.x + v * std::cos(s.theta) * dt, s.pos.y + v * std::sin(s.theta) * dt};
+        next.theta = s.theta + w * dt;
+
+        const RobotState& ref = reference.poses[std::min(k, reference.poses.size() - 1)];
+        const double ex = next.pos.x - ref.pos.x;
+        const double ey = next.pos.y - ref.pos.y;
+        const double et = wrap_angle(next.theta - ref.theta);
+        const double dl = u[k].wl - prev.wl;
+        const double dr = u[k].wr - prev.wr;
+        cost += config.Q_POS * (ex * ex + ey * ey) + config.Q_THETA * et * et
+              + config.R_U * (u[k].wl * u[k].wl + u[k].wr * u[k].wr)
+              + config.R_DU * (dl * dl + dr * dr);
+        prev = u[k];
+    }
+    return cost;
+}
+
+void MpcTracker::gradient(const TrackingReference& reference, std::vector<WheelCommand>& grad) {
+    // Adjoint pass over the rollout stored by the last rollout_cost(u_)
+    const double dt = config.DT;
+    const std::size_t n = u_.size();
+    double lx = 0.0;
+    double ly = 0.0;
+    double lt = 0.0;
+    for(std::size_t k = n; k-- > 0;) {
+        const RobotState& next = states_[k + 1];
+        const RobotState& ref = reference.poses[std::min(k, reference.poses.size() - 1)];
+        lx += 2.0 * config.Q_POS * (next.pos.x - ref.pos.x);
+        ly += 2.0 * config.Q_POS * (next.pos.y - ref.pos.y);
+        lt += 2.0 * config.Q_THETA * wrap_angle(next.theta - ref.theta);
+
+        const double theta = states_[k].theta;
+        const double c = std::cos(theta);
+        const double s = std::sin(theta);
+        const double v = r_ * (u_[k].wr + u_[k].wl) / 2.0;
+        const double dj_dv = (lx * c + ly * s) * dt;
+        const double dj_dw = lt * dt;
+
+        const WheelCommand& prev = k > 0 ? u_[k - 1] : applied_;
+        double gl = dj_dv * r_ / 2.0 - dj_dw * r_ / wheelbase_ + 2.0 * config.R_U * u_[k].wl + 2.0 * config.R_DU * (u_[k].wl - prev.wl);
+        double gr = dj_dv * r_ / 2.0 + dj_dw * r_ / wheelbase_ + 2.0 * config.R_U * u_[k].wr + 2.0 * config.R_DU * (u_[k].wr - prev.wr);
+        if(k + 1 < n) {
+            gl -= 2.0 * config.R_DU * (u_[k + 1].wl - u_[k].wl);
+            gr -= 2.0 * config.R_DU * (u_[k + 1].wr - u_[k].wr);
+        }
+        grad[k] = {gl, gr};
+
+        // Propagate the co-state through the heading dependence of the motion
+        lt += lx * (-v * s * dt) + ly * (v * c * dt);
+    }
+}
+
+std::pair<double, double> MpcTracker::solve(const RobotState& state, const TrackingReference& reference) {
+    const auto t0 = std::chrono::steady_clock::now();
+
+    if(reference.poses.empty()) {
+        return {0.0, 0.0};
+    }
+
+    // Warm start: the previous solution shifted by one step
+    if(u_.size() > 1) {
+        std::rotate(u_.begin(), u_.begin() + 1, u_.end());
+        u_.back() = u_[u_.size() - 2];
+    }
+    project(u_);
+
+    double cost = rollout_cost(state, reference, u_);
+    int iterations = 0;
+    for(; iterations < config.MAX_ITERATIONS; iterations++) {
+        gradient(reference, grad_);
+
+        // Backtracking on the projected step
+        bool accepted = false;
+        double improvement = 0.0;
+        for(int tries = 0; tries < 8; tries++) {
+            for(std::size_t k = 0; k < u_.size(); k++) {
+                candidate_[k] = {u_[k].wl - step_ * grad_[k].wl, u_[k].wr - step_ * grad_[k].wr};
+            }
+            project(candidate_);
+            const double candidate_cost = rollout_cost(state, reference, candidate_);
+            if(candidate_cost < cost) {
+                improvement = cost - candidate_cost;
+                cost = candidate_cost;
+                std::swap(u_, candidate_);
+                step_ = std::min(step_ * 1.5, 100.0 * config.STEP);
+                accepted = true;
+                break;
+            }
+            step_ *= 0.5;
+        }
+        if(!accepted) {
+            // Leave the stored rollout consistent with u_
+            cost = rollout_cost(state, reference, u_);
+            step_ = config.STEP;
+            break;
+        }
+        if(improvement < config.TOLERANCE * cost) {
+            break;
+        }
+    }
+
+    applied_ = u_.front();
+
+    const double elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    stats_.solves++;
+    stats_.last_solve_us = elapsed_us;
+    stats_.mean_solve_us += (elapsed_us - stats_.mean_solve_us) / static_cast<double>(stats_.solves);
+    stats_.max_solve_us = std::max(stats_.max_solve_us, elapsed_us);
+    stats_.last_iterations = iterations;
+    stats_.last_cost = cost;
+    if(stats_.solves % 100 == 0) {
+        BOOST_LOG_TRIVIAL(debug) << fmt::format("[mpc]: {} solves, last {:.0f} us ({} iterations), mean {:.0f} us, max {:.0f} us",
+            stats_.solves, stats_.last_solve_us, stats_.last_iterations, stats_.mean_solve_us, stats_.max_solve_us);
+    }
+
+    const double v = r_ * (applied_.wr + applied_.wl) / 2.0;
+    const double w = r_ * (applied_.wr - applied_.wl) / wheelbase_;
+    return {v, w};
+}
+
+} // namespace lrn
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <liblrn/rover.hpp>
+#include <liblrn/rover-config.hpp>
+#include <liblrn/mpc-tracker-config.hpp>
+
+namespace lrn {
+
+struct WheelCommand {
+    double wl, wr;  // wheel angular speeds (rad/s)
+};
+
+struct TrackingReference {
+    std::vector<RobotState> poses;  // one per prediction step, starting one step ahead
+};
+
+struct MpcStatistics {
+    std::uint64_t solves = 0;
+    double last_solve_us = 0.0;
+    double mean_solve_us = 0.0;
+    double max_solve_us = 0.0;
+    int last_iterations = 0;
+    double last_cost = 0.0;
+};
+
+/**
+ * @brief Model predictive tracker for the differential-drive model.
+ *
+ * Optimises the wheel speeds over a short horizon with projected gradient
+ * descent (gradients from the adjoint of the unicycle rollout), under wheel
+ * speed and acceleration limits. Each solve is warm-started from the
+ * previous solution shifted by one step.
+ */
+class MpcTracker {
+public:
+    MpcTracker(const RoverConfig& rover_cfg, MpcTrackerConfig& cfg);
+
+    std::size_t horizon() const { return u_.size(); }
+    double dt() const { return config.DT; }
+
+    /**
+     * @brief Solves from the current state, returns the first (v, w) to apply.
+     */
+    std::pair<double, double> solve(const RobotState& state, const TrackingReference& reference);
+
+    void reset();
+
+    const MpcStatistics& statistics() const { return stats_; }
+
+private:
+    double rollout_cost(const RobotState& state, const TrackingReference& reference, const std::vector<WheelCommand>& u);
+    void gradient(const TrackingReference& reference, std::vector<WheelCommand>& grad);
+    void project(std::vector<WheelCommand>& u) const;
+
+    MpcTrackerConfig& config;
+    double r_;
+    double wheelbase_;
+    double max_wheel_speed_;
+    double max_wheel_step_;     // max wheel speed change per prediction step
+
+    std::vector<WheelCommand> u_;
+    std::vector<WheelCommand> candidate_;
+    std::vector<WheelCommand> grad_;
+    std::vector<RobotState> states_;  // rollout of the last evaluated candidate
+    WheelCommand applied_ {0.0, 0.0};
+    double step_;
+
+    MpcStatistics stats_;
+};
+
+} // namespace lrn
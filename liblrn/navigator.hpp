@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string_view>
+
+namespace lrn {
+
+/**
+ * @brief Local planner stepped by the executor once per control period.
+ */
+class Navigator {
+public:
+    virtual ~Navigator() = default;
+
+    virtual std::string_view name() const = 0;
+    virtual void step() = 0;
+};
+
+} // namespace lrn
@@ -0,0 +1,98 @@
+#include <liblrn/occupancy-grid.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace lrn {
+
+OccupancyGrid::OccupancyGrid(double resolution, int width, int height)
+    : resolution_(resolution)
+    , width_(width)
+    , height_(height)
+    , log_odds_(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), 0.0f)
+{}
+
+bool OccupancyGrid::contains(const GridCell& cell) const {
+    return cell.x >= 0 && cell.y >= 0 && cell.x < width_ && cell.y < height_;
+}
+
+std::optional<GridCell> OccupancyGrid::world_to_cell(const Vec2& p) const {
+    // The navigation origin sits in the middle of the grid
+    GridCell cell {
+        static_cast<int>(std::floor(p.x / resolution_)) + width_ / 2,
+        static_cast<int>(std::floor(p.y / resolution_)) + height_ / 2
+    };
+    if(!contains(cell)) {
+        return std::nullopt;
+    }
+    return cell;
+}
+
+Vec2 OccupancyGrid::cell_to_world(const GridCell& cell) const {
+    return {
+        (cell.x - width_ / 2 + 0.5) * resolution_,
+        (cell.y - height_ / 2 + 0.5) * resolution_
+    };
+}
+
+bool OccupancyGrid::is_occupied(const GridCell& cell) const {
+    return log_odds_[index(cell)] > log_odds_occupied;
+}
+
+void OccupancyGrid::observe(const GridCell& cell, float delta, std::vector<GridCell>& changed) {
+    float& value = log_odds_[index(cell)];
+    const bool was_occupied = value > log_odds_occupied;
+    value = std::clamp(value + delta, log_odds_min, log_odds_max);
+    if(was_occupied != (value > log_odds_occupied)) {
+        changed.push_back(cell);
+    }
+}
+
+void OccupancyGrid::integrate_ray(const Vec2& from, const Vec2& to, bool hit, std::vector<GridCell>& changed) {
+    const auto start = world_to_cell(from);
+    if(!start) {
+        return;
+    }
+    const GridCell end {
+        static_cast<int>(std::floor(to.x / resolution_)) + width_ / 2,
+        static_cast<int>(std::floor(to.y / resolution_)) + height_ / 2
+    };
+
+    // Bresenham line walk, the end cell is handled separately
+    int x = start->x;
+    int y = start->y;
+    const int dx = std::abs(end.x - x);
+    const int dy = -std::abs(end.y - y);
+    const int sx = x < end.x ? 1 : -1;
+    const int sy = y < end.y ? 1 : -1;
+    int err = dx + dy;
+
+    while(x != end.x || y != end.y) {
+        const GridCell cell {x, y};
+        if(!contains(cell)) {
+            return;
+        }
+        observe(cell, log_odds_miss, changed);
+
+        const int e2 = 2 * err;
+        if(e2 >= dy) {
+            err += dy;
+            x += sx;
+        }
+        if(e2 <= dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+
+    if(contains(end)) {
+        observe(end, hit ? log_odds_hit : log_odds_miss, changed);
+    }
+}
+
+void OccupancyGrid::clear() {
+    std::fill(log_odds_.begin(), log_odds_.end(), 0.0f);
+}
+
+} // namespace lrn
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <liblrn/rover.hpp>
+
+namespace lrn {
+
+struct GridCell {
+    int x, y;
+
+    bool operator==(const GridCell&) const = default;
+};
+
+/**
+ * @brief Log-odds occupancy grid centred on the navigation origin.
+ *
+ * Cells are updated by casting IR rays from the sensor position: every cell
+ * crossed by the ray is observed free and the end cell is observed occupied
+ * (unless the reading is at maximum range).
+ */
+class OccupancyGrid {
+public:
+    OccupancyGrid(double resolution, int width, int height);
+
+    double resolution() const { return resolution_; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    bool contains(const GridCell& cell) const;
+    std::optional<GridCell> world_to_cell(const Vec2& p) const;
+    Vec2 cell_to_world(const GridCell& cell) const;
+
+    std::size_t index(const GridCell& cell) const {
+        return static_cast<std::size_t>(cell.y) * static_cast<std::size_t>(width_) + static_cast<std::size_t>(cell.x);
+    }
+
+    bool is_occupied(const GridCell& cell) const;
+
+    /**
+     * @brief Integrates one range measurement.
+     * @param changed receives the cells whose occupied/free state flipped
+     */
+    void integrate_ray(const Vec2& from, const Vec2& to, bool hit, std::vector<GridCell>& changed);
+
+    void clear();
+
+private:
+    void observe(const GridCell& cell, float delta, std::vector<GridCell>& changed);
+
+    static constexpr float log_odds_hit = 0.85f;
+    static constexpr float log_odds_miss = -0.4f;
+    static constexpr float log_odds_min = -2.0f;
+    static constexpr float log_odds_max = 3.5f;
+    static constexpr float log_odds_occupied = 0.7f;
+
+    double resolution_;
+    int width_;
+    int height_;
+    std::vector<float> log_odds_;
+};
+
+} // namespace lrn
@@ -0,0 +1,25 @@
+#include <liblrn/pose-estimator-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <string_view>
+
+namespace lrn {
+
+PoseEstimatorConfig tag_invoke( boost::json::value_to_tag< PoseEstimatorConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    PoseEstimatorConfig config;
+    extract_optional( obj, config.linear_acceleration_noise, PoseEstimatorConfig::CONFIG_LINEAR_ACCELERATION_NOISE);
+    extract_optional( obj, config.angular_acceleration_noise, PoseEstimatorConfig::CONFIG_ANGULAR_ACCELERATION_NOISE);
+    extract_optional( obj, config.command_v_noise, PoseEstimatorConfig::CONFIG_COMMAND_V_NOISE);
+    extract_optional( obj, config.command_w_noise, PoseEstimatorConfig::CONFIG_COMMAND_W_NOISE);
+    extract_optional( obj, config.gyro_noise, PoseEstimatorConfig::CONFIG_GYRO_NOISE);
+    extract_optional( obj, config.max_dt, PoseEstimatorConfig::CONFIG_MAX_DT);
+
+    return config;
+}
+
+} // namespace lrn
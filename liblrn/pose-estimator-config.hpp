@@ -0,0 +1,28 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <string_view>
+
+namespace lrn {
+
+class PoseEstimatorConfig
+{
+public:
+    static constexpr std::string_view CONFIG_LINEAR_ACCELERATION_NOISE = {"linear_acceleration_noise"};
+    static constexpr std::string_view CONFIG_ANGULAR_ACCELERATION_NOISE = {"angular_acceleration_noise"};
+    static constexpr std::string_view CONFIG_COMMAND_V_NOISE = {"command_v_noise"};
+    static constexpr std::string_view CONFIG_COMMAND_W_NOISE = {"command_w_noise"};
+    static constexpr std::string_view CONFIG_GYRO_NOISE = {"gyro_noise"};
+    static constexpr std::string_view CONFIG_MAX_DT = {"max_dt"};
+
+    double linear_acceleration_noise = 0.5;     // process noise of v (m/s^2)
+    double angular_acceleration_noise = 2.0;    // process noise of w (rad/s^2)
+    double command_v_noise = 0.05;              // std of v implied by the wheel command (m/s)
+    double command_w_noise = 0.3;               // std of w implied by the wheel command (rad/s)
+    double gyro_noise = 0.02;                   // std of the gyro z rate (rad/s)
+    double max_dt = 0.1;                        // longest prediction step, longer gaps are clamped (s)
+};
+
+PoseEstimatorConfig tag_invoke( boost::json::value_to_tag< PoseEstimatorConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
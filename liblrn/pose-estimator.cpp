@@ -0,0 +1,150 @@
+#include <liblrn/pose-estimator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace lrn {
+
+namespace {
+constexpr double initial_velocity_variance = 1e-4;
+}
+
+template<std::floating_point T>
+BasicPoseEstimator<T>::BasicPoseEstimator(const PoseEstimatorConfig& cfg)
+    : config(cfg)
+{
+    p_[V][V] = static_cast<T>(initial_velocity_variance);
+    p_[W][W] = static_cast<T>(initial_velocity_variance);
+}
+
+template<std::floating_point T>
+void BasicPoseEstimator<T>::reset(const RobotState& state, std::chrono::steady_clock::time_point stamp) {
+    x_ = {static_cast<T>(state.pos.x), static_cast<T>(state.pos.y), static_cast<T>(state.theta), T{0}, T{0}};
+    p_ = {};
+    p_[V][V] = static_cast<T>(initial_velocity_variance);
+    p_[W][W] = static_cast<T>(initial_velocity_variance);
+    stamp_ = stamp;
+    initialised_ = true;
+}
+
+template<std::floating_point T>
+void BasicPoseEstimator<T>::predict(std::chrono::steady_clock::time_point stamp) {
+    if(!initialised_) {
+        stamp_ = stamp;
+        initialised_ = true;
+        return;
+    }
+    const T dt = static_cast<T>(std::min(std::chrono::duration<double>(stamp - stamp_).count(), config.max_dt));
+    stamp_ = stamp;
+    if(!(dt > T{0})) {
+        return;
+    }
+
+    const T c = std::cos(x_[THETA]);
+    const T s = std::sin(x_[THETA]);
+    const T v = x_[V];
+
+    x_[X] += v * c * dt;
+    x_[Y] += v * s * dt;
+    x_[THETA] = wrap_angle(x_[THETA] + x_[W] * dt);
+
+    // F = I + dF, only the pose rows have off-diagonal terms
+    Matrix f {};
+    for(std::size_t i = 0; i < state_size; i++) {
+        f[i][i] = T{1};
+    }
+    f[X][THETA] = -v * s * dt;
+    f[X][V] = c * dt;
+    f[Y][THETA] = v * c * dt;
+    f[Y][V] = s * dt;
+    f[THETA][W] = dt;
+
+    // P = F P F^T + Q
+    Matrix fp {};
+    for(std::size_t i = 0; i < state_size; i++) {
+        for(std::size_t j = 0; j < state_size; j++) {
+            T sum {0};
+            for(std::size_t k = 0; k < state_size; k++) {
+                sum += f[i][k] * p_[k][j];
+            }
+            fp[i][j] = sum;
+        }
+    }
+    for(std::size_t i = 0; i < state_size; i++) {
+        for(std::size_t j = i; j < state_size; j++) {
+            T sum {0};
+            for(std::size_t k = 0; k < state_size; k++) {
+                sum += fp[i][k] * f[j][k];
+            }
+            p_[i][j] = sum;
+            p_[j][i] = sum;
+        }
+    }
+    p_[V][V] += static_cast<T>(config.linear_acceleration_noise * config.linear_acceleration_noise) * dt;
+    p_[W][W] += static_cast<T>(config.angular_acceleration_noise * config.angular_acceleration_noise) * dt;
+}
+
+template<std::floating_point T>
+void BasicPoseEstimator<T>::correct(const ScalarObservation& observation) {
+    const Vector& h = observation.jacobian;
+
+    // P H^T and the innovation variance
+    Vector ph {};
+    for(std::size_t i = 0; i < state_size; i++) {
+        T sum {0};
+        for(std::size_t k = 0; k < state_size; k++) {
+            sum += p_[i][k] * h[k];
+        }
+        ph[i] = sum;
+    }
+    T innovation_variance = observation.variance;
+    for(std::size_t k = 0; k < state_size; k++) {
+        innovation_variance += h[k] * ph[k];
+    }
+    if(!(innovation_variance > T{0})) {
+        return;
+    }
+
+    const T innovation = observation.value - observation.predicted;
+    for(std::size_t i = 0; i < state_size; i++) {
+        x_[i] += ph[i] / innovation_variance * innovation;
+    }
+    x_[THETA] = wrap_angle(x_[THETA]);
+
+    // P -= K (H P), with K = P H^T / S; H P is (P H^T)^T as P is symmetric
+    for(std::size_t i = 0; i < state_size; i++) {
+        for(std::size_t j = i; j < state_size; j++) {
+            const T value = p_[i][j] - ph[i] * ph[j] / innovation_variance;
+            p_[i][j] = value;
+            p_[j][i] = value;
+        }
+    }
+}
+
+template<std::floating_point T>
+void BasicPoseEstimator<T>::observe_gyro_z(double w) {
+    correct({static_cast<T>(w), x_[W], {T{0}, T{0}, T{0}, T{0}, T{1}}, static_cast<T>(config.gyro_noise * config.gyro_noise)});
+}
+
+template<std::floating_point T>
+void BasicPoseEstimator<T>::observe_command(const Twist& command) {
+    correct({static_cast<T>(command.v), x_[V], {T{0}, T{0}, T{0}, T{1}, T{0}}, static_cast<T>(config.command_v_noise * config.command_v_noise)});
+    correct({static_cast<T>(command.w), x_[W], {T{0}, T{0}, T{0}, T{0}, T{1}}, static_cast<T>(config.command_w_noise * config.command_w_noise)});
+}
+
+template<std::floating_point T>
+PoseEstimate BasicPoseEstimator<T>::estimate() const {
+    PoseEstimate e {};
+    e.state.pos = {static_cast<double>(x_[X]), static_cast<double>(x_[Y])};
+    e.state.theta = static_cast<double>(x_[THETA]);
+    e.twist = {static_cast<double>(x_[V]), static_cast<double>(x_[W])};
+    e.variance = {static_cast<double>(p_[X][X]), static_cast<double>(p_[Y][Y]), static_cast<double>(p_[THETA][THETA])};
+    e.stamp = stamp_;
+    return e;
+}
+
+template class BasicPoseEstimator<float>;
+template class BasicPoseEstimator<double>;
+
+} // namespace lrn
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+#include <liblrn/geometry.hpp>
+#include <liblrn/scalar.hpp>
+#include <liblrn/pose-estimator-config.hpp>
+
+namespace lrn {
+
+struct PoseEstimate {
+    RobotState state;
+    Twist twist;
+    std::array<double, 3> variance;     // x, y, theta
+    std::chrono::steady_clock::time_point stamp;
+};
+
+/**
+ * @brief Extended Kalman filter for dead reckoning of the differential drive.
+ *
+ * State is [x, y, theta, v, w] with a unicycle model and random-walk
+ * velocities. Sources are folded in as scalar observations (value, predicted
+ * value, Jacobian row, variance), so adding one (wheel encoders, a heading
+ * reference, a localisation fix) is a matter of building its rows. The filter
+ * is not thread-safe; it is stepped on the thread receiving the samples.
+ *
+ * Templated on the floating-point type of the filter arithmetic.
+ */
+template<std::floating_point T>
+class BasicPoseEstimator {
+public:
+    static constexpr std::size_t state_size = 5;
+    enum Index : std::size_t { X = 0, Y, THETA, V, W };
+
+    using Vector = std::array<T, state_size>;
+    using Matrix = std::array<Vector, state_size>;
+
+    struct ScalarObservation {
+        T value;
+        T predicted;
+        Vector jacobian;
+        T variance;
+    };
+
+    explicit BasicPoseEstimator(const PoseEstimatorConfig& cfg);
+
+    void reset(const RobotState& state, std::chrono::steady_clock::time_point stamp);
+
+    /**
+     * @brief Propagates the state up to the given time.
+     */
+    void predict(std::chrono::steady_clock::time_point stamp);
+
+    void correct(const ScalarObservation& observation);
+
+    void observe_gyro_z(double w);
+    void observe_command(const Twist& command);
+
+    PoseEstimate estimate() const;
+
+private:
+    const PoseEstimatorConfig& config;
+    Vector x_ {};
+    Matrix p_ {};
+    std::chrono::steady_clock::time_point stamp_ {};
+    bool initialised_ = false;
+};
+
+extern template class BasicPoseEstimator<float>;
+extern template class BasicPoseEstimator<double>;
+
+// Covariances fall below the fixed-point resolution, so fixed-point builds run the filter in float
+using estimator_real = std::conditional_t<std::floating_point<real>, real, float>;
+using PoseEstimator = BasicPoseEstimator<estimator_real>;
+
+} // namespace lrn
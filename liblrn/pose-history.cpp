@@ -0,0 +1,78 @@
+#include <liblrn/pose-history.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace lrn {
+
+PoseHistory::PoseHistory(std::size_t capacity)
+    : entries_(std::max<std::size_t>(capacity, 2))
+{}
+
+void PoseHistory::push(clock::time_point stamp, const RobotState& state) {
+    const std::lock_guard lock(mutex_);
+    // Out of order samples would break the binary search
+    if(size_ > 0 && stamp < entry(size_ - 1).stamp) {
+        return;
+    }
+    if(size_ < entries_.size()) {
+        entries_[(head_ + size_) % entries_.size()] = {stamp, state};
+        size_++;
+    } else {
+        entries_[head_] = {stamp, state};
+        head_ = (head_ + 1) % entries_.size();
+    }
+}
+
+void PoseHistory::clear() {
+    const std::lock_guard lock(mutex_);
+    head_ = 0;
+    size_ = 0;
+}
+
+std::optional<RobotState> PoseHistory::at(clock::time_point stamp) const {
+    const std::lock_guard lock(mutex_);
+    if(size_ == 0 || stamp < entry(0).stamp || entry(size_ - 1).stamp < stamp) {
+        return std::nullopt;
+    }
+
+    // First entry newer than stamp
+    std::size_t lo = 0;
+    std::size_t hi = size_;
+    while(lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if(stamp < entry(mid).stamp) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    if(lo == size_) {
+        return entry(size_ - 1).state;
+    }
+
+    const Entry& before = entry(lo - 1);
+    const Entry& after = entry(lo);
+    const double span = std::chrono::duration<double>(after.stamp - before.stamp).count();
+    const double t = span > 0.0 ? std::chrono::duration<double>(stamp - before.stamp).count() / span : 0.0;
+
+    RobotState state = before.state;
+    state.pos = {before.state.pos.x + t * (after.state.pos.x - before.state.pos.x),
+                 before.state.pos.y + t * (after.state.pos.y - before.state.pos.y)};
+    state.theta = wrap_angle(before.state.theta + t * wrap_angle(after.state.theta - before.state.theta));
+    return state;
+}
+
+Vec2 reproject(const Vec2& point, const RobotState& observed_from, const RobotState& current) {
+    // Body of observed_from -> world -> body of current
+    const double ca = std::cos(observed_from.theta);
+    const double sa = std::sin(observed_from.theta);
+    const double wx = observed_from.pos.x + ca * point.x - sa * point.y - current.pos.x;
+    const double wy = observed_from.pos.y + sa * point.x + ca * point.y - current.pos.y;
+    const double cn = std::cos(current.theta);
+    const double sn = std::sin(current.theta);
+    return {cn * wx + sn * wy, -sn * wx + cn * wy};
+}
+
+} // namespace lrn
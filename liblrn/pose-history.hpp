@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <liblrn/geometry.hpp>
+
+namespace lrn {
+
+/**
+ * @brief Ring buffer of past poses, looked up and interpolated by timestamp.
+ *
+ * Poses are pushed in time order by the estimator; lookups binary search the
+ * ring, O(log n), and interpolate linearly between the two poses around the
+ * requested time (heading along the shortest arc).
+ */
+class PoseHistory {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit PoseHistory(std::size_t capacity);
+
+    void push(clock::time_point stamp, const RobotState& state);
+    void clear();
+
+    /**
+     * @brief Pose at the given time; empty when it is older than the buffer or newer than the last pose.
+     */
+    std::optional<RobotState> at(clock::time_point stamp) const;
+
+private:
+    struct Entry {
+        clock::time_point stamp;
+        RobotState state;
+    };
+
+    // i-th oldest entry
+    const Entry& entry(std::size_t i) const { return entries_[(head_ + i) % entries_.size()]; }
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Expresses a point observed in the body frame at one pose in the body frame of another.
+ */
+Vec2 reproject(const Vec2& point, const RobotState& observed_from, const RobotState& current);
+
+} // namespace lrn
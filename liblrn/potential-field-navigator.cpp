@@ -1,6 +1,7 @@
 #include <liblrn/potential-field-navigator.hpp>
+#include <algorithm>
 #include <cmath>
-#include <numbers>
+#include <tuple>
 #include <liblrn/rover.hpp>
 #include <liblrn/potential-field-navigator-config.hpp>
 
@@ -10,14 +11,15 @@ double dist(const Vec2& a, const Vec2& b) {
     return std::hypot(a.x - b.x, a.y - b.y);
 }
 
-PotentialFieldNavigator::PotentialFieldNavigator(Rover& rover, PotentialFieldNavigatorConfig &cfg)
+PotentialFieldNavigator::PotentialFieldNavigator(Rover& rover, PotentialFieldNavigatorConfig &cfg, const DStarLitePlanner *planner, double lookahead, MpcTracker *tracker)
     : rover_(rover)
     , config(cfg)
+    , planner_(planner)
+    , lookahead_(lookahead)
+    , tracker_(tracker)
     {}
 
 void PotentialFieldNavigator::step() {
-    using namespace std::numbers;
-
     const double K_ATT = config.K_ATT;
     const double K_REP = config.K_REP;
     const double RHO_0 = config.RHO_0;
@@ -27,56 +29,58 @@ void PotentialFieldNavigator::step() {
 
     auto state = rover_.getState();
     Vec2 goal = rover_.getGoalPosition();
-    auto sensors = rover_.readSensors();
-
-    // Attractive force
-    double dx_att = state.pos.x - goal.x;
-    double dy_att = state.pos.y - goal.y;
-    double fx_att = -K_ATT * dx_att;
-    double fy_att = -K_ATT * dy_att;
+    const auto obstacles = rover_.readObstacles();
 
-    // Repulsive force
-    double fx_rep = 0.0;
-    double fy_rep = 0.0;
-    double ir_sensors_delta = 30.0 * pi / 180.0;
-    double ir_sensors_theta_start = 30.0 * pi / 180.0;
-
-    for (size_t i = 0; i < 3; ++i) {
-        if (sensors.ir[i]) {
-            double rho = *sensors.ir[i];
-            double sensor_theta = ir_sensors_theta_start - i * ir_sensors_delta;
-            double obs_x = rho * std::cos(sensor_theta);
-            double obs_y = rho * std::sin(sensor_theta);
-            double factor = -K_REP * std::exp(-rho / RHO_0);
-            if (rho > 1e-5) { // avoid division by zero
-                fx_rep += factor * obs_x / rho;
-                fy_rep += factor * obs_y / rho;
-            }
+    // Follow the global path when one is available
+    if (planner_) {
+        const auto path = planner_->current_path();
+        if (path && !path->waypoints.empty()) {
+            goal = path_lookahead(*path, state.pos, lookahead_);
         }
     }
 
-    double fx = fx_att + fx_rep;
-    double fy = fy_att + fy_rep;
-
-    // Compute heading error
-    double theta_d = std::atan2(fy, fx);
-    double e_theta = theta_d - state.theta;
-    while (e_theta > pi) e_theta -= 2 * pi;
-    while (e_theta < -pi) e_theta += 2 * pi;
+    // The obstacles are in the rover frame, so is the field: its direction is the heading error
+    const double ct = std::cos(state.theta);
+    const double st = std::sin(state.theta);
+    const double gdx = goal.x - state.pos.x;
+    const double gdy = goal.y - state.pos.y;
+    const double e_theta = static_cast<double>(potential_field_direction(
+        static_cast<real>(ct * gdx + st * gdy), static_cast<real>(-st * gdx + ct * gdy), obstacles,
+        static_cast<real>(K_ATT), static_cast<real>(K_REP), static_cast<real>(RHO_0)));
+    const double theta_d = wrap_angle(state.theta + e_theta);
 
-    // Angular control
-    double omega = std::clamp(K_THETA * e_theta, -W_MAX, W_MAX);
+    double omega = 0.0;
+    double v = 0.0;
+    if (tracker_) {
+        // Track a straight reference along the field direction at V_MAX, stopping at the goal
+        const double goal_dist = dist(state.pos, goal);
+        reference_.poses.resize(tracker_->horizon());
+        for (std::size_t k = 0; k < reference_.poses.size(); ++k) {
+            const double s = std::min(V_MAX * tracker_->dt() * static_cast<double>(k + 1), goal_dist);
+            auto& pose = reference_.poses[k];
+            pose = state;
+            pose.pos = {state.pos.x + s * std::cos(theta_d), state.pos.y + s * std::sin(theta_d)};
+            pose.theta = theta_d;
+        }
+        std::tie(v, omega) = tracker_->solve(state, reference_);
+    } else {
+        // Angular control
+        omega = std::clamp(K_THETA * e_theta, -W_MAX, W_MAX);
 
-    // Forward velocity control
-    double v = V_MAX * std::cos(e_theta);
-    if (v < 0) v = 0;
+        // Forward velocity control
+        v = V_MAX * std::cos(e_theta);
+        if (v < 0) v = 0;
+    }
 
     if (dist(state.pos, goal) < 0.1) {
         v = 0;
         omega = 0;
+        if (tracker_) {
+            tracker_->reset();
+        }
     }
 
-    //rover_.drive(v, omega);
+    rover_.drive(v, omega);
 }
 
 } // namespace lrn
@@ -1,19 +1,57 @@
 #pragma once
+#include <liblrn/navigator.hpp>
+#include <liblrn/scalar.hpp>
 #include <liblrn/rover.hpp>
 #include <liblrn/potential-field-navigator-config.hpp>
+#include <liblrn/dstar-lite-planner.hpp>
+#include <liblrn/mpc-tracker.hpp>
 
 namespace lrn {
 
-class PotentialFieldNavigator {
+/**
+ * @brief Direction (rad) of the attractive force towards the goal plus the IR repulsion.
+ *
+ * The goal offset and the obstacle points are in the same frame, the rover
+ * body frame for readObstacles(), and so is the returned direction.
+ */
+template<Scalar T>
+T potential_field_direction(T goal_dx, T goal_dy, const IrObservations& obstacles, T k_att, T k_rep, T rho_0) {
+    // Attractive force
+    T fx = k_att * goal_dx;
+    T fy = k_att * goal_dy;
+
+    // Repulsive force
+    for (const auto& obstacle : obstacles) {
+        if (obstacle) {
+            const T ox = static_cast<T>(obstacle->point.x);
+            const T oy = static_cast<T>(obstacle->point.y);
+            const T rho = math::hypot(ox, oy);
+            if (T {1e-5} < rho) { // avoid division by zero
+                const T factor = -k_rep * math::exp(-rho / rho_0);
+                fx += factor * ox / rho;
+                fy += factor * oy / rho;
+            }
+        }
+    }
+
+    return math::atan2(fy, fx);
+}
+
+class PotentialFieldNavigator : public Navigator {
 
 public:
-    explicit PotentialFieldNavigator(Rover& rover, PotentialFieldNavigatorConfig &cfg);
+    explicit PotentialFieldNavigator(Rover& rover, PotentialFieldNavigatorConfig &cfg, const DStarLitePlanner *planner = nullptr, double lookahead = 0.3, MpcTracker *tracker = nullptr);
     
-    void step();
+    std::string_view name() const override { return "potential_field"; }
+    void step() override;
     
 private:
     Rover& rover_;
     PotentialFieldNavigatorConfig& config;
+    const DStarLitePlanner *planner_;
+    double lookahead_;
+    MpcTracker *tracker_;
+    TrackingReference reference_;
 };
 
 }
@@ -14,8 +14,16 @@ RoverConfig tag_invoke( boost::json::value_to_tag< RoverConfig > /*unused*/, boo
     RoverConfig config;
     extract( obj, config.wheelbase, RoverConfig::CONFIG_WHEELBASE);
     extract( obj, config.wheel_radius, RoverConfig::CONFIG_WHEEL_RADIUS);
+    extract_optional( obj, config.max_wheel_speed, RoverConfig::CONFIG_MAX_WHEEL_SPEED);
+    extract_optional( obj, config.max_wheel_acceleration, RoverConfig::CONFIG_MAX_WHEEL_ACCELERATION);
     extract( obj, config.platform, RoverConfig::CONFIG_PLATFORM);
     extract_optional( obj, config.remote, RoverConfig::CONFIG_REMOTE_API);
+    extract_optional( obj, config.estimator, RoverConfig::CONFIG_ESTIMATOR);
+    extract_optional( obj, config.gyro_bias, RoverConfig::CONFIG_GYRO_BIAS);
+    extract_optional( obj, config.attitude, RoverConfig::CONFIG_ATTITUDE);
+    extract_optional( obj, config.motors, RoverConfig::CONFIG_MOTORS);
+    extract_optional( obj, config.yaw_rate, RoverConfig::CONFIG_YAW_RATE);
+    extract_optional( obj, config.profiler, RoverConfig::CONFIG_PROFILER);
 
     return config;
 }
@@ -6,6 +6,12 @@
 #include <boost/json.hpp>
 #include <liblrn/rover-platform-config.hpp>
 #include <liblrn/rover-remote-config.hpp>
+#include <liblrn/pose-estimator-config.hpp>
+#include <liblrn/gyro-bias-config.hpp>
+#include <liblrn/attitude-filter-config.hpp>
+#include <liblrn/motor-model-config.hpp>
+#include <liblrn/yaw-rate-controller-config.hpp>
+#include <liblrn/velocity-profiler-config.hpp>
 
 namespace lrn {
 
@@ -14,13 +20,29 @@ class RoverConfig
 public:
     static constexpr std::string_view CONFIG_WHEELBASE = {"wheelbase"};
     static constexpr std::string_view CONFIG_WHEEL_RADIUS = {"wheel_radius"};
+    static constexpr std::string_view CONFIG_MAX_WHEEL_SPEED = {"max_wheel_speed"};
+    static constexpr std::string_view CONFIG_MAX_WHEEL_ACCELERATION = {"max_wheel_acceleration"};
     static constexpr std::string_view CONFIG_PLATFORM = {"platform"};
     static constexpr std::string_view CONFIG_REMOTE_API = {"remote_api"};
+    static constexpr std::string_view CONFIG_ESTIMATOR = {"estimator"};
+    static constexpr std::string_view CONFIG_GYRO_BIAS = {"gyro_bias"};
+    static constexpr std::string_view CONFIG_ATTITUDE = {"attitude"};
+    static constexpr std::string_view CONFIG_MOTORS = {"motors"};
+    static constexpr std::string_view CONFIG_YAW_RATE = {"yaw_rate"};
+    static constexpr std::string_view CONFIG_PROFILER = {"profiler"};
 
     double wheelbase;
     double wheel_radius;
+    double max_wheel_speed = 11.84;         // rad/s, planning limit, kept within the motor tables
+    double max_wheel_acceleration = 20.0;   // rad/s^2
     RoverPlatformConfig platform;
     std::optional<RoverRemoteConfig> remote;
+    PoseEstimatorConfig estimator;
+    GyroBiasConfig gyro_bias;
+    AttitudeFilterConfig attitude;
+    MotorModelConfig motors;
+    YawRateControllerConfig yaw_rate;
+    VelocityProfilerConfig profiler;
 };
 
 RoverConfig tag_invoke( boost::json::value_to_tag< RoverConfig > /*unused*/, boost::json::value const& json_value );
@@ -1,27 +1,172 @@
 #include <liblrn/rover-executor.hpp>
 #include <liblrn/rover.hpp>
+#include <liblrn/navigator.hpp>
 #include <liblrn/potential-field-navigator.hpp>
-#include <liblrn/rover-config.hpp>
-#include <liblrn/potential-field-navigator-config.hpp>
+#include <liblrn/dynamic-window-navigator.hpp>
+#include <liblrn/dstar-lite-planner.hpp>
+#include <liblrn/mpc-tracker.hpp>
+#include <liblrn/monte-carlo-localizer.hpp>
+#include <liblrn/step-monitor.hpp>
+#include <liblrn/lrn-config.hpp>
+#include <boost/log/trivial.hpp>
 #include <fmt/format.h>
+#include <nlohmann/json.hpp>
 #include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+using json = nlohmann::json;
 
 namespace lrn {
 
-void RoverExecutor::run(RoverConfig &rover_config, PotentialFieldNavigatorConfig &navigator_config) {
+namespace {
+json step_statistics(const std::map<std::string, StepTimeHistogram, std::less<>>& histograms, const StepWatchdog& watchdog, const MpcTracker* tracker, const MonteCarloLocalizer* localizer, const std::optional<YawRateStatistics>& yaw_rate) {
+    json navigators = json::object();
+    for (const auto& [name, histogram] : histograms) {
+        navigators[name] = {
+            {"count", histogram.count()},
+            {"overruns", histogram.overruns()},
+            {"mean_us", histogram.mean_us()},
+            {"p50_us", histogram.quantile_us(0.5)},
+            {"p99_us", histogram.quantile_us(0.99)},
+            {"max_us", histogram.max_us()},
+            {"bucket_bounds_us", StepTimeHistogram::bucket_bounds_us},
+            {"buckets", histogram.counts()}
+        };
+    }
+    json j = {
+        {"navigators", navigators},
+        {"watchdog", {{"missed_deadlines", watchdog.missed_deadlines()}, {"trips", watchdog.trips()}}}
+    };
+    if (tracker) {
+        const auto& mpc = tracker->statistics();
+        j["mpc"] = {
+            {"solves", mpc.solves},
+            {"last_us", mpc.last_solve_us},
+            {"mean_us", mpc.mean_solve_us},
+            {"max_us", mpc.max_solve_us},
+            {"iterations", mpc.last_iterations}
+        };
+    }
+    if (yaw_rate) {
+        j["yaw_rate"] = {
+            {"samples", yaw_rate->samples},
+            {"rms_error", yaw_rate->rms_error},
+            {"max_error", yaw_rate->max_error},
+            {"saturated", yaw_rate->saturated},
+            {"integral", yaw_rate->integral}
+        };
+    }
+    if (localizer) {
+        const auto estimate = localizer->getEstimate();
+        j["localization"] = {
+            {"x", estimate.state.pos.x},
+            {"y", estimate.state.pos.y},
+            {"theta", estimate.state.theta},
+            {"position_std", estimate.position_std},
+            {"heading_std", estimate.heading_std},
+            {"particles", estimate.particles},
+            {"updates", estimate.updates},
+            {"last_us", estimate.last_update_us}
+        };
+    }
+    return j;
+}
+}
+
+void RoverExecutor::run(LRnConfig &config) {
     Rover rover;
-    rover.init(rover_config);
-    PotentialFieldNavigator navigator(rover, navigator_config);
+    rover.init(config.rover);
+    if (config.mission) {
+        rover.mission().configure(*config.mission);
+    }
+
+    std::unique_ptr<DStarLitePlanner> planner;
+    double lookahead = 0.0;
+    if (config.planner && config.planner->enabled) {
+        planner = std::make_unique<DStarLitePlanner>(*config.planner);
+        lookahead = config.planner->lookahead;
+        planner->start(rover);
+    }
 
+    std::unique_ptr<MonteCarloLocalizer> localizer;
+    if (config.localization && config.localization->enabled) {
+        localizer = std::make_unique<MonteCarloLocalizer>(*config.localization);
+        if (!localizer->start(rover)) {
+            BOOST_LOG_TRIVIAL(warning) << "Localization disabled, no arena map";
+            localizer.reset();
+        }
+    }
+
+    std::unique_ptr<MpcTracker> tracker;
+    if (config.mpc && config.mpc->enabled) {
+        tracker = std::make_unique<MpcTracker>(config.rover, *config.mpc);
+        BOOST_LOG_TRIVIAL(info) << fmt::format("MPC tracking enabled, horizon {} x {:.2f} s", tracker->horizon(), tracker->dt());
+    }
+
+    std::unique_ptr<Navigator> navigator;
+    if (config.local_planner == LRnConfig::LOCAL_PLANNER_DYNAMIC_WINDOW) {
+        navigator = std::make_unique<DynamicWindowNavigator>(rover, config.rover, config.dynamic_window, planner.get(), lookahead);
+    } else {
+        navigator = std::make_unique<PotentialFieldNavigator>(rover, config.navigator, planner.get(), lookahead, tracker.get());
+    }
+    BOOST_LOG_TRIVIAL(info) << fmt::format("Local planner: {}", navigator->name());
+
+    const auto period = std::chrono::milliseconds(config.control_loop.period_ms);
+    const auto budget = std::chrono::milliseconds(config.control_loop.budget_ms);
+    const auto stats_period = std::chrono::milliseconds(config.control_loop.stats_period_ms);
+
+    std::map<std::string, StepTimeHistogram, std::less<>> histograms;
+    StepWatchdog watchdog(rover, config.control_loop);
+    watchdog.start();
+
+    auto next_step = std::chrono::steady_clock::now();
+    auto last_stats = next_step;
     while (!should_stop_) {
-        using namespace std::chrono_literals;
-        navigator.step();
-        // Add dt sleep if running in real-time
-        std::this_thread::sleep_for(50ms);
+        const auto t0 = std::chrono::steady_clock::now();
+        navigator->step();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0);
+
+        const bool on_time = elapsed <= budget;
+        watchdog.kick(on_time);
+        if (!on_time) {
+            BOOST_LOG_TRIVIAL(warning) << fmt::format("[{}]: step took {} us, budget {} ms", navigator->name(), elapsed.count(), budget.count());
+        }
+
+        auto histogram = histograms.find(navigator->name());
+        if (histogram == histograms.end()) {
+            histogram = histograms.emplace(std::string(navigator->name()), StepTimeHistogram{}).first;
+        }
+        histogram->second.record(elapsed, !on_time);
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_stats >= stats_period) {
+            last_stats = now;
+            rover.publishStats(step_statistics(histograms, watchdog, tracker.get(), localizer.get(),
+                config.rover.yaw_rate.enabled ? std::optional(rover.yawRateStatistics()) : std::nullopt).dump());
+        }
+
+        // Fixed rate; periods lost to a slow step are skipped rather than caught up
+        next_step += period;
+        if (next_step < now) {
+            next_step = now;
+        }
+        std::this_thread::sleep_until(next_step);
+    }
+
+    watchdog.stop();
+    if (localizer) {
+        localizer->stop();
+    }
+    if (planner) {
+        planner->stop();
     }
 }
 
 void RoverExecutor::stop() {
     should_stop_ = true;
 }
-}
\ No newline at end of file
+}
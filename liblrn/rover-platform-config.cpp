@@ -13,6 +13,11 @@ RoverPlatformConfig tag_invoke( boost::json::value_to_tag< RoverPlatformConfig >
     boost::json::object const& obj = json_value.as_object();
     RoverPlatformConfig config;
     extract( obj, config.port, RoverPlatformConfig::CONFIG_PORTNAME);
+    extract_optional( obj, config.sample_period_ms, RoverPlatformConfig::CONFIG_SAMPLE_PERIOD_MS);
+    extract_optional( obj, config.watchdog_periods, RoverPlatformConfig::CONFIG_WATCHDOG_PERIODS);
+    extract_optional( obj, config.keepalive_fraction, RoverPlatformConfig::CONFIG_KEEPALIVE_FRACTION);
+    extract_optional( obj, config.imu_period_ms, RoverPlatformConfig::CONFIG_IMU_PERIOD_MS);
+    extract_optional( obj, config.temperature_period_ms, RoverPlatformConfig::CONFIG_TEMPERATURE_PERIOD_MS);
 
     return config;
 }
@@ -9,10 +9,20 @@ class RoverPlatformConfig
 {
 public:
     static constexpr std::string_view CONFIG_PORTNAME = {"port"};    
+    static constexpr std::string_view CONFIG_SAMPLE_PERIOD_MS = {"sample_period_ms"};
+    static constexpr std::string_view CONFIG_WATCHDOG_PERIODS = {"watchdog_periods"};
+    static constexpr std::string_view CONFIG_KEEPALIVE_FRACTION = {"keepalive_fraction"};
+    static constexpr std::string_view CONFIG_IMU_PERIOD_MS = {"imu_period_ms"};
+    static constexpr std::string_view CONFIG_TEMPERATURE_PERIOD_MS = {"temperature_period_ms"};
 
     std::string port;
+    int sample_period_ms = 100;         // firmware sensor period requested with <start>, 20..1000
+    int watchdog_periods = 3;           // ConsiderMotion in the firmware: motors stop after this many periods without <ws>
+    double keepalive_fraction = 0.5;    // unchanged wheel commands are repeated after this fraction of the watchdog window
+    int imu_period_ms = 5;              // IMU channel period requested with <sr>, 0 turns it off, else 2..10000
+    int temperature_period_ms = 1000;   // temperature channel period, same range
 };
 
 RoverPlatformConfig tag_invoke( boost::json::value_to_tag< RoverPlatformConfig > /*unused*/, boost::json::value const& json_value );
 
-} // namespace lrn
\ No newline at end of file
+} // namespace lrn
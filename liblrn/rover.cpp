@@ -1,8 +1,11 @@
 #include <liblrn/rover.hpp>
+#include <liblrn/kinematics.hpp>
 
+#include <charconv>
 #include <istream>
 #include <regex>
 #include <numbers>
+#include <cmath>
 
 #include <boost/log/trivial.hpp>
 #include <fmt/format.h>
@@ -21,6 +24,12 @@ Rover::Rover(const boost::posix_time::milliseconds read_deadline_expiry)
     , read_interbytedeadline_timer_(io_context)
     , serial_port(io_context)
     , is_remote_enabled(false)
+    , estimator_(config.estimator)
+    , gyro_bias_(config.gyro_bias)
+    , attitude_filter_(config.attitude)
+    , motor_model_(config.motors)
+    , yaw_rate_controller_(config.yaw_rate)
+    , profiler_(config.profiler)
 {
     io_context_thread = std::thread([this]() { io_context.run(); });
     data_pieces_regex = std::regex(lrn::data_regex.data());
@@ -39,6 +48,11 @@ Rover::~Rover()
     if(motors_commands_thread.joinable()) {
         motors_commands_thread.join();
     }
+
+    should_stop_ = true;
+    if(profiler_thread_.joinable()) {
+        profiler_thread_.join();
+    }
 }
 
 void Rover::start_async_read() {
@@ -66,6 +80,10 @@ void Rover::init(RoverConfig &cfg) {
 
 #endif // WIN32
 
+    gyro_bias_.load();
+    motor_model_.load();
+    yaw_rate_controller_.set_limits(std::min(motor_model_.left().max_speed(), motor_model_.right().max_speed()), config.wheelbase, config.wheel_radius);
+
     is_remote_enabled = config.remote.has_value() && config.remote.value().enabled;
     if(is_remote_enabled) {
         // initialize the zmq context with a single IO thread
@@ -80,6 +98,7 @@ void Rover::init(RoverConfig &cfg) {
         motors_subscriber.set(zmq::sockopt::subscribe, motors_setup_topic);
         motors_subscriber.set(zmq::sockopt::subscribe, motors_commands_topic);
         motors_subscriber.set(zmq::sockopt::subscribe, tilt_motor_command_topic);
+        motors_subscriber.set(zmq::sockopt::subscribe, mission_topic);
 
         motors_commands_thread = std::thread([this]() { motor_commands_executor(); });
     }
@@ -88,61 +107,332 @@ void Rover::init(RoverConfig &cfg) {
     set_connection_parameters(name, 115200, boost::asio::serial_port_base::parity::none, boost::asio::serial_port_base::stop_bits::one);
     open_connection();
     start_async_read();
+
+    if(config.profiler.enabled) {
+        profiler_thread_ = std::thread([this]() { run_profiler(); });
+    }
 }
 
 SensorReading Rover::readSensors() {
-    return last_reading;
+    return reading_.load();
 }
 
 RobotState Rover::getState() {
-    // Retrieve robot pose from odometry/state estimator
-    RobotState state{/*pos=*/{0, 0}, /*theta=*/0};
-    return state;
+    return pose_.load().state;
+}
+
+PoseEstimate Rover::getPoseEstimate() {
+    return pose_.load();
+}
+
+std::optional<RobotState> Rover::getStateAt(std::chrono::steady_clock::time_point stamp) {
+    return pose_history_.at(stamp);
+}
+
+IrObservations Rover::readObstacles() {
+    const auto sensors = readSensors();
+    const auto current = getState();
+    const auto observed_from = pose_history_.at(sensors.stamp).value_or(current);
+
+    IrObservations obstacles;
+    for(std::size_t i = 0; i < ir_sensors_count; i++) {
+        if(!sensors.ir[i]) {
+            continue;
+        }
+        const double rho = *sensors.ir[i];
+        const double sensor_theta = ir_sensors_theta_start - static_cast<double>(i) * ir_sensors_delta;
+        obstacles[i] = IrObservation{reproject({rho * std::cos(sensor_theta), rho * std::sin(sensor_theta)}, observed_from, current), rho};
+    }
+    return obstacles;
 }
 
 Vec2 Rover::getGoalPosition() {
-    // Retrieve/set goal
-    return {1, 1};
+    // Goal of the active mission waypoint; with none the rover holds its position
+    const auto state = getState();
+    const auto goal = mission_.update(state.pos);
+    publish_mission_progress();
+    return goal.value_or(state.pos);
 }
 
 void Rover::drive(double v, double w) {
+    if(config.profiler.enabled) {
+        profiler_.set_target({v, w}, std::chrono::steady_clock::now());
+        return;
+    }
+    drive_twist(v, w);
+}
+
+void Rover::run_profiler() {
+    const auto period = std::chrono::milliseconds(std::max(config.profiler.period_ms, 1));
+    auto next_step = std::chrono::steady_clock::now();
+    while(!should_stop_) {
+        {
+            // Repeated every period while engaged, which also keeps the firmware watchdog fed
+            const std::lock_guard lock(profiler_mutex_);
+            if(const auto twist = profiler_.step(std::chrono::steady_clock::now())) {
+                drive_twist(twist->v, twist->w);
+            }
+        }
+
+        next_step += period;
+        const auto now = std::chrono::steady_clock::now();
+        if(next_step < now) {
+            next_step = now;
+        }
+        std::this_thread::sleep_until(next_step);
+    }
+}
+
+void Rover::release_profiler() {
+    // Waits for a profile step in flight, it must not land after a direct wheel command
+    const std::lock_guard lock(profiler_mutex_);
+    profiler_.reset();
+}
+
+void Rover::release_yaw_rate() {
+    // Waits for a loop step in flight, its wheel command must not land after a direct one
+    const std::lock_guard lock(yaw_rate_mutex_);
+    yaw_rate_controller_.release();
+}
+
+void Rover::drive_twist(double v, double w) {
+    std::unique_lock lock(yaw_rate_mutex_, std::defer_lock);
+    if(config.yaw_rate.enabled) {
+        // Sent right away with the current correction, the loop refines it with the next gyro samples
+        lock.lock();
+        w = yaw_rate_controller_.engage({v, w}).w;
+    }
+
     // Transform to wheel velocities
-    double vr = v + (config.wheelbase / 2.0) * w;
-    double vl = v - (config.wheelbase / 2.0) * w;
+    const auto wheels = twist_to_wheels(static_cast<real>(v), static_cast<real>(w), static_cast<real>(config.wheelbase), static_cast<real>(config.wheel_radius));
+
+    command_wheels(static_cast<double>(wheels.left), static_cast<double>(wheels.right));
+}
+
+void Rover::driveWheels(double wl, double wr) {
+    release_profiler();
+    release_yaw_rate();
+    command_wheels(wl, wr);
+}
+
+void Rover::command_wheels(double wl, double wr) {
+    const auto [dl, dr] = wheel_duty(wl, wr);
+    write_wheel_duty(dl, dr);
+}
 
-    double wr = vr / config.wheel_radius;
-    double wl = vl / config.wheel_radius;
+std::pair<int, int> Rover::wheel_duty(double wl, double wr) {
+    const auto& left = motor_model_.left();
+    const auto& right = motor_model_.right();
+    const auto dl = std::clamp(static_cast<int>(left.duty(wl)), -255, 255);
+    const auto dr = std::clamp(static_cast<int>(right.duty(wr)), -255, 255);
 
-    driveWheels(wl, wr);
+    // Wheels inside the motor dead band do not turn
+    set_commanded_wheels(dl != 0 ? std::clamp(wl, -left.max_speed(), left.max_speed()) : 0.0,
+                         dr != 0 ? std::clamp(wr, -right.max_speed(), right.max_speed()) : 0.0);
+    return {dl, dr};
 }
 
-double computeDutyFromOmega(double omega) {
-    if(std::abs(omega) < 4.32) {
-        return 0.0;
+bool Rover::uploadWheelProfile(const std::vector<WheelSpeeds<double>>& setpoints, std::chrono::milliseconds step) {
+    if(setpoints.empty() || setpoints.size() > wheel_profile_max_steps
+        || step.count() < wheel_profile_min_step_ms || step.count() > wheel_profile_max_step_ms) {
+        BOOST_LOG_TRIVIAL(warning) << fmt::format("[motors]: wheel profile of {} steps of {} ms does not fit a frame", setpoints.size(), step.count());
+        return false;
     }
-    if(omega > 11.84) {
-        return 255.0;
+
+    release_profiler();
+    release_yaw_rate();
+    std::string frame = fmt::format("<wp,{},{}", 1 + 2 * setpoints.size(), step.count());
+    std::pair<int, int> duty;
+    for(const auto& setpoint : setpoints) {
+        // The dead reckoning is left with the last setpoint as its command
+        duty = wheel_duty(setpoint.left, setpoint.right);
+        frame += fmt::format(",{},{}", duty.first, duty.second);
     }
-    
-    double result = 0.0443*std::pow(omega, 5.0) - 1.6146*std::pow(omega, 4.0) + 23.227*std::pow(omega, 3.0) - 162.59*std::pow(omega, 2.0) + 561.92*omega - 731.89;
-    return result;
+    frame += ">\r\n";
+    write_wheel_profile(std::move(frame), duty, step * static_cast<int>(setpoints.size()));
+    return true;
 }
 
+bool Rover::rampWheels(double wl, double wr, double acceleration) {
+    if(!(acceleration > 0.0)) {
+        return false;
+    }
 
-void Rover::driveWheels(double wl, double wr) {
-    double ddl = computeDutyFromOmega(std::abs(wl));
-    double ddr = computeDutyFromOmega(std::abs(wr));
-    if(wl < 0.0) {
-        ddl *= -1.0;
+    std::pair<int, int> from {0, 0};
+    {
+        const std::lock_guard lock(wheel_command_mutex_);
+        from = sent_duty_.value_or(from);
     }
-    if(wr < 0.0) {
-        ddr *= -1.0;
+    release_profiler();
+    release_yaw_rate();
+    const auto to = wheel_duty(wl, wr);
+
+    // Time the larger wheel speed change takes, expressed as a duty rate for that wheel
+    const auto& left = motor_model_.left();
+    const auto& right = motor_model_.right();
+    const double change = std::max(std::abs(left.speed(to.first) - left.speed(from.first)), std::abs(right.speed(to.second) - right.speed(from.second)));
+    const int duty_change = std::max(std::abs(to.first - from.first), std::abs(to.second - from.second));
+    const double seconds = change / acceleration;
+    const int rate = seconds > 0.0
+        ? std::clamp(static_cast<int>(std::ceil(duty_change / seconds)), wheel_ramp_min_rate, wheel_ramp_max_rate)
+        : wheel_ramp_max_rate;
+
+    write_wheel_profile(fmt::format("<wr,3,{},{},{}>\r\n", to.first, to.second, rate), to,
+                        std::chrono::milliseconds(1000 * duty_change / rate));
+    return true;
+}
+
+void Rover::write_wheel_profile(std::string frame, std::pair<int, int> last, std::chrono::steady_clock::duration duration) {
+    const std::lock_guard lock(wheel_command_mutex_);
+    write(reinterpret_cast<uint8_t*>(frame.data()), frame.length());
+
+    // A <ws> would cancel the profile, the keepalive for its last setpoint is due after it ends
+    sent_duty_ = last;
+    sent_duty_stamp_ = std::chrono::steady_clock::now() + duration;
+    wheel_frames_sent_++;
+}
+
+std::chrono::steady_clock::duration Rover::keepalive_period() const {
+    // The firmware stops moving motors when no <ws> arrives for watchdog_periods sensor periods
+    const auto period = firmware_period_.count() > 0 ? firmware_period_ : std::chrono::milliseconds(config.platform.sample_period_ms);
+    const auto window = std::chrono::duration<double, std::milli>(period * std::max(config.platform.watchdog_periods, 1));
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(window * std::clamp(config.platform.keepalive_fraction, 0.0, 1.0));
+}
+
+void Rover::write_wheel_duty(int dl, int dr, bool force) {
+    const std::lock_guard lock(wheel_command_mutex_);
+    const auto now = std::chrono::steady_clock::now();
+    const std::pair duty {dl, dr};
+
+    // Same setpoint: stopped wheels need no refresh, moving ones only before the watchdog expires
+    if(!force && sent_duty_ == duty && (duty == std::pair {0, 0} || now - sent_duty_stamp_ < keepalive_period())) {
+        wheel_frames_suppressed_++;
+        return;
     }
-    const auto dl = std::clamp(static_cast<int>(ddl), -255, 255);
-    const auto dr =  std::clamp(static_cast<int>(ddr), -255, 255);
 
     std::string cmd = fmt::format("<ws,2,{},{}>\r\n", dl, dr);
-    write(reinterpret_cast<uint8_t*>(cmd.data()), cmd.length());    
+    write(reinterpret_cast<uint8_t*>(cmd.data()), cmd.length());
+    sent_duty_ = duty;
+    sent_duty_stamp_ = now;
+    wheel_frames_sent_++;
+
+    if(now - wheel_stats_stamp_ >= std::chrono::seconds(10)) {
+        BOOST_LOG_TRIVIAL(debug) << fmt::format("[motors]: {} wheel frames sent, {} duplicates suppressed", wheel_frames_sent_, wheel_frames_suppressed_);
+        wheel_stats_stamp_ = now;
+    }
+}
+
+void Rover::start_sampling(int period_ms) {
+    // Payload of one value, a bare <start,N> is read by the firmware as a length and falls back to 1 s
+    std::string cmd = fmt::format("<start,1,{}>\r\n", period_ms);
+    write(reinterpret_cast<uint8_t*>(cmd.data()), cmd.length());
+    // Each sensor channel at its own period: IMU, IR, temperature
+    cmd = fmt::format("<sr,3,{},{},{}>\r\n", config.platform.imu_period_ms, period_ms, config.platform.temperature_period_ms);
+    write(reinterpret_cast<uint8_t*>(cmd.data()), cmd.length());
+
+    const std::lock_guard lock(wheel_command_mutex_);
+    firmware_period_ = std::chrono::milliseconds(period_ms);
+    // The watchdog restarts with the new period, resend whatever is commanded next
+    sent_duty_.reset();
+}
+
+void Rover::stop_sampling() {
+    std::string cmd = "<stop,0>\r\n";
+    write(reinterpret_cast<uint8_t*>(cmd.data()), cmd.length());
+
+    // <stop> also stops the motors
+    const std::lock_guard lock(wheel_command_mutex_);
+    sent_duty_ = std::pair {0, 0};
+}
+
+void Rover::set_commanded_wheels(double wl, double wr) {
+    const auto [v, w] = wheels_to_twist(WheelSpeeds<double>{wl, wr}, config.wheelbase, config.wheel_radius);
+    commanded_twist_.store({v, w});
+}
+
+void Rover::stopWheels() {
+    release_profiler();
+    release_yaw_rate();
+    set_commanded_wheels(0.0, 0.0);
+    write_wheel_duty(0, 0, true);
+}
+
+bool Rover::hold_wheel_duty(int dl, int dr, std::chrono::milliseconds duration) {
+    // The firmware stops moving motors when no <ws> arrives for a few sensor periods (60 ms at 20 ms)
+    const auto until = std::chrono::steady_clock::now() + duration;
+    while(!should_stop_ && std::chrono::steady_clock::now() < until) {
+        write_wheel_duty(dl, dr);
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(std::chrono::milliseconds(20), until - std::chrono::steady_clock::now()));
+    }
+    return !should_stop_;
+}
+
+bool Rover::calibrateMotors() {
+    const auto& cal = config.motors.calibration;
+    const auto sample_period = std::chrono::milliseconds(std::max(cal.sample_period_ms, 1));
+
+    start_sampling(cal.sample_period_ms);
+    stopWheels();
+    BOOST_LOG_TRIVIAL(info) << fmt::format("[motors]: calibrating, keep the rover still for {} ms", cal.still_ms);
+    bool completed = hold_wheel_duty(0, 0, std::chrono::milliseconds(cal.still_ms));
+
+    // (duty, wheel speed) for the left and right wheel
+    std::array<std::vector<std::pair<double, double>>, 2> samples;
+    for(std::size_t wheel = 0; wheel < samples.size() && completed; wheel++) {
+        const bool is_left = wheel == 0;
+        const auto& model = is_left ? motor_model_.left() : motor_model_.right();
+        for(int duty = cal.duty_min; duty <= cal.duty_max && completed; duty += std::max(cal.duty_step, 1)) {
+            // Announce the expected speed, a steady spin must not be taken for standing still by the gyro bias tracking
+            const double nominal = model.speed(duty);
+            set_commanded_wheels(is_left ? nominal : 0.0, is_left ? 0.0 : nominal);
+            const int dl = is_left ? duty : 0;
+            const int dr = is_left ? 0 : duty;
+            if(!hold_wheel_duty(dl, dr, std::chrono::milliseconds(cal.settle_ms))) {
+                completed = false;
+                break;
+            }
+
+            double sum = 0.0;
+            int count = 0;
+            const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(cal.measure_ms);
+            while(!should_stop_ && std::chrono::steady_clock::now() < until) {
+                sum += pose_.load().state.attitude.yaw_rate;
+                count++;
+                write_wheel_duty(dl, dr);
+                std::this_thread::sleep_for(sample_period);
+            }
+            const double rate = count > 0 ? sum / count : 0.0;
+
+            // One wheel turning pivots the rover about the other one
+            const double omega = std::abs(rate) * config.wheelbase / config.wheel_radius;
+            if(std::abs(rate) >= cal.min_rate && (rate > 0.0) == is_left) {
+                BOOST_LOG_TRIVIAL(warning) << fmt::format("[motors]: {} wheel turns the rover the wrong way, check the motor wiring", is_left ? "left" : "right");
+            }
+            BOOST_LOG_TRIVIAL(info) << fmt::format("[motors]: {} duty {} -> yaw {:.3f} rad/s, wheel {:.2f} rad/s", is_left ? "left" : "right", duty, rate, omega);
+            samples[wheel].emplace_back(duty, omega);
+        }
+        stopWheels();
+        completed = completed && hold_wheel_duty(0, 0, std::chrono::milliseconds(cal.settle_ms));
+    }
+
+    stopWheels();
+    stop_sampling();
+    if(!completed) {
+        BOOST_LOG_TRIVIAL(warning) << "[motors]: calibration interrupted";
+        return false;
+    }
+
+    const double min_speed = cal.min_rate * config.wheelbase / config.wheel_radius;
+    const auto left = fit_motor_table(samples[0], min_speed);
+    const auto right = fit_motor_table(samples[1], min_speed);
+    if(!left || !right) {
+        BOOST_LOG_TRIVIAL(error) << fmt::format("[motors]: cannot fit the {} wheel table, too few moving samples", !left ? "left" : "right");
+        return false;
+    }
+    motor_model_.update(*left, *right);
+    BOOST_LOG_TRIVIAL(info) << fmt::format("[motors]: calibrated, dead band {:.2f}/{:.2f} rad/s, max {:.2f}/{:.2f} rad/s",
+        motor_model_.left().dead_band(), motor_model_.right().dead_band(), motor_model_.left().max_speed(), motor_model_.right().max_speed());
+    return true;
 }
 
 void Rover::tilt(double alpha) {
@@ -151,26 +441,6 @@ void Rover::tilt(double alpha) {
     write(reinterpret_cast<uint8_t*>(cmd.data()), cmd.length());    
 }
 
-/* Finds in which interval the digital value belongs to
-*   If it is lower than the starting value, -1 is returned
-*   If is higher than the last value, the last value is returned
-*   Else, returns the lower value of the interval to which it belongs to
-*/
-int find_interval(long int target) {
-     //menor que o primeiro
-     if (target < ir_lut_values[0].x)
-         return -1; // Fora da tabela (abaixo)
-     // maior que o último
-     if (target >= ir_lut_values[LUT_SIZE-1].x)
-         return LUT_SIZE-1;
-     // Procura o long intervalo correto
-     for (size_t i = 0; i < LUT_SIZE - 1; i++) {
-         if (target >= ir_lut_values[i].x && target < ir_lut_values[i+1].x)
-             return static_cast<int>(i);
-     }
-     return -1;
- }
-
  double computeDistance(double x) {
     return -2.1587 * x * x + 3.9694 * x + 0.3499;
 }
@@ -193,17 +463,9 @@ void Rover::handle_ir_sensors_values(std::vector<double> values) {
         //    last_reading.ir[i] = 0.8;
         //}
 
-        long int item = find_interval(values[i]);
-        if(item != -1) {
-            long int dx = values[i] - ir_lut_values[item].x;
-            long int dy = -ir_lut_values[item].m * dx;
-            double dist = (ir_lut_values[item].mm + (dy>>10)) / 1000.0;
-            last_reading.ir[i] = dist;
-        } else {
-            last_reading.ir[i] = 0.8;
-        }
-        
+        last_reading.ir[i] = static_cast<double>(ir_adc_to_distance(static_cast<real>(values[i])));
     }
+    last_reading.stamp = sample_stamp_;
     BOOST_LOG_TRIVIAL(warning) << fmt::format("[IR]: {}, {}, {}", last_reading.ir[0].value(), last_reading.ir[1].value(), last_reading.ir[2].value());
 }
 
@@ -220,7 +482,9 @@ void Rover::handle_acc_sensors_values(std::vector<double> values) {
 
     last_reading.acc[0] = acc_x_g;
     last_reading.acc[1] = acc_y_g;
-    last_reading.acc[2] = acc_z_g;    
+    last_reading.acc[2] = acc_z_g;
+
+    gyro_bias_.add_acceleration({acc_x_g, acc_y_g, acc_z_g});
 }
 
 void Rover::handle_gyro_sensors_values(std::vector<double> values) {
@@ -230,13 +494,48 @@ void Rover::handle_gyro_sensors_values(std::vector<double> values) {
         return;
     }
 
-    double gyr_x_dps = values[0]/ BMI323_GYRO_SCALE_1000DPS;
-    double gyr_y_dps = values[1]/ BMI323_GYRO_SCALE_1000DPS;
-    double gyr_z_dps = values[2]/ BMI323_GYRO_SCALE_1000DPS;
+    const auto commanded = commanded_twist_.load();
+    const auto rate = gyro_bias_.correct({values[0] / BMI323_GYRO_SCALE_1000DPS, values[1] / BMI323_GYRO_SCALE_1000DPS, values[2] / BMI323_GYRO_SCALE_1000DPS}, commanded);
+    double gyr_x_dps = rate[0];
+    double gyr_y_dps = rate[1];
+    double gyr_z_dps = rate[2];
 
     last_reading.gyro[0] = gyr_x_dps;
     last_reading.gyro[1] = gyr_y_dps;
     last_reading.gyro[2] = gyr_z_dps;
+
+    // One estimator and attitude step per IMU sample
+    const auto now = sample_stamp_;
+    constexpr double deg_to_rad = std::numbers::pi / 180.0;
+    estimator_.predict(now);
+    estimator_.observe_command(commanded);
+    estimator_.observe_gyro_z(gyr_z_dps * deg_to_rad);
+    if(last_reading.acc[0] && last_reading.acc[1] && last_reading.acc[2]) {
+        attitude_filter_.update({gyr_x_dps * deg_to_rad, gyr_y_dps * deg_to_rad, gyr_z_dps * deg_to_rad},
+                                {*last_reading.acc[0], *last_reading.acc[1], *last_reading.acc[2]}, now);
+    }
+    {
+        // Engagement checked and the wheels commanded in one go, release_yaw_rate() waits for it
+        const std::lock_guard lock(yaw_rate_mutex_);
+        if(const auto twist = yaw_rate_controller_.update(gyr_z_dps * deg_to_rad, now)) {
+            const auto wheels = twist_to_wheels(static_cast<real>(twist->v), static_cast<real>(twist->w), static_cast<real>(config.wheelbase), static_cast<real>(config.wheel_radius));
+            command_wheels(static_cast<double>(wheels.left), static_cast<double>(wheels.right));
+        }
+    }
+    auto estimate = estimator_.estimate();
+    estimate.state.attitude = attitude_filter_.attitude();
+    pose_.store(estimate);
+    pose_history_.push(estimate.stamp, estimate.state);
+}
+
+void Rover::handle_temperature_values(std::vector<double> values) {
+
+    if(values.size() != 1) {
+        BOOST_LOG_TRIVIAL(error) << fmt::format("[rover]: TEMP expected 1 value, but got {}", values.size());
+        return;
+    }
+
+    last_reading.temperature = values[0] / BMI323_TEMPERATURE_SCALE + BMI323_TEMPERATURE_OFFSET;
 }
 
 void Rover::handle_sensors_value(const std::string &sensor, std::vector<double> values) {
@@ -247,31 +546,54 @@ void Rover::handle_sensors_value(const std::string &sensor, std::vector<double>
         handle_acc_sensors_values(std::move(values));
     } else if(sensor == "gyr"){
         handle_gyro_sensors_values(std::move(values));
+    } else if(sensor == "temp"){
+        handle_temperature_values(std::move(values));
+    } else if(sensor == "time"){
+        // Consumed with the whole line, see handle_read_packet
     } else {
         BOOST_LOG_TRIVIAL(error) << fmt::format("[rover]: Unknown sensor '{}'", sensor);
     }
 }
 
-void Rover::handle_read_packet(boost::asio::streambuf &buffer, std::size_t /*bytes_transferred*/) {
+void Rover::handle_read_packet(std::size_t bytes_transferred) {
+    sensor_stream_.feed(std::span(read_serial_buffer.data(), bytes_transferred),
+        [this](std::string_view line) { handle_sensor_line(line); },
+        [this](const SensorPacket& packet) { handle_sensor_packet(packet); });
+}
 
-    std::istream is(&buffer);
-    std::string line;
-    std::getline(is, line);
-    
+void Rover::handle_sensor_line(std::string_view line_view) {
+    const std::string line(line_view);
     std::sregex_iterator first_match = std::sregex_iterator(line.begin(), line.end(), data_pieces_regex);
     std::sregex_iterator last_match;
 
     
+    // Acquisition time of the line, from the sensor time when the MCU reports it
+    const auto received = std::chrono::steady_clock::now();
+    sample_stamp_ = received;
+    for(auto it = first_match; it != last_match; ++it) {
+        if((*it)[1] == "time") {
+            const std::string field = (*it)[3];
+            std::uint32_t sensor_ms = 0;
+            const auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), sensor_ms);
+            if(ec != std::errc() || end != field.data() + field.size()) {
+                BOOST_LOG_TRIVIAL(warning) << fmt::format("[rover]: Dropping sensor line with bad time '{}'", field);
+                return;
+            }
+            sample_stamp_ = sensor_clock_.to_host(sensor_ms, received);
+        }
+    }
+
     auto current_match = first_match;
-    bool has_readings = current_match != last_match;
+    bool has_ir = false;
     while(current_match != last_match) {
         std::smatch match = *current_match;
         // match[0] = whole match
-        // match[1] = ir/acc/gyro
+        // match[1] = ir/acc/gyr/temp/time
         // match[2] = count
         // match[3] = value (possibly comma-separated numbers)
 
         std::string sensor = match[1];
+        has_ir = has_ir || sensor == "ir";
         int count = std::stoi(match[2]);
         std::string values_str = match[3];
 
@@ -292,25 +614,110 @@ void Rover::handle_read_packet(boost::asio::streambuf &buffer, std::size_t /*byt
         ++current_match;
     }
 
-    if(is_remote_enabled && has_readings) {
+    reading_.store(last_reading);
+
+    // IMU lines of the FIFO stream come at the IMU rate, see handle_sensor_packet
+    if(has_ir) {
+        publish_sensors();
+    }
+}
+
+void Rover::handle_sensor_packet(const SensorPacket& packet) {
+    const auto received = std::chrono::steady_clock::now();
+    sample_stamp_ = sensor_clock_.to_host(packet.sensor_time, received);
+
+    // Same order and units as the fields of a line
+    const bool ir = packet.type == sensor_packet_type_sample || packet.type == sensor_packet_type_ir;
+    const bool imu = packet.type == sensor_packet_type_sample || packet.type == sensor_packet_type_imu;
+    const bool temperature = packet.type == sensor_packet_type_sample || packet.type == sensor_packet_type_temperature;
+    if(ir) {
+        handle_ir_sensors_values({static_cast<double>(packet.ir[0]), static_cast<double>(packet.ir[1]), static_cast<double>(packet.ir[2])});
+    }
+    if(imu) {
+        handle_acc_sensors_values({static_cast<double>(packet.acc[0]), static_cast<double>(packet.acc[1]), static_cast<double>(packet.acc[2])});
+        handle_gyro_sensors_values({static_cast<double>(packet.gyr[0]), static_cast<double>(packet.gyr[1]), static_cast<double>(packet.gyr[2])});
+    }
+    if(temperature) {
+        handle_temperature_values({static_cast<double>(packet.temperature)});
+    }
+    reading_.store(last_reading);
+
+    // IMU samples come at the IMU rate, the remote gets the sensors at the IR period
+    if(ir) {
+        publish_sensors();
+    }
+}
+
+void Rover::publish_sensors() {
+    if(is_remote_enabled) {
         json j;
 
         const auto sensorsReadings = readSensors();
         j = {
             {"ir", {sensorsReadings.ir[0], sensorsReadings.ir[1], sensorsReadings.ir[2]}},
             {"acc", {sensorsReadings.acc[0], sensorsReadings.acc[1], sensorsReadings.acc[2]}},
-            {"gyro", {sensorsReadings.gyro[0], sensorsReadings.gyro[1], sensorsReadings.gyro[2]}}
+            {"gyro", {sensorsReadings.gyro[0], sensorsReadings.gyro[1], sensorsReadings.gyro[2]}},
+            {"temperature", sensorsReadings.temperature}
+        };
+        const auto state = getState();
+        j["pose"] = {{"x", state.pos.x}, {"y", state.pos.y}, {"theta", state.theta}};
+        const auto& attitude = state.attitude;
+        j["attitude"] = {
+            {"q", {attitude.q.w, attitude.q.x, attitude.q.y, attitude.q.z}},
+            {"roll", attitude.roll},
+            {"pitch", attitude.pitch},
+            {"yaw_rate", attitude.yaw_rate}
         };
 
-        std::string str = j.dump();
-        zmq::message_t sensors_data(str);
-
-        sensors_publisher.send(zmq::str_buffer("lunar-rover-sensors"), zmq::send_flags::sndmore);
-        
-        sensors_publisher.send(sensors_data, zmq::send_flags::none);
+        publish(sensors_topic, j.dump());
     }    
 }
 
+void Rover::publish(std::string_view topic, const std::string& payload) {
+    // The publisher is shared by the I/O and navigation threads
+    const std::lock_guard lock(publisher_mutex);
+    sensors_publisher.send(zmq::buffer(topic.data(), topic.size()), zmq::send_flags::sndmore);
+    sensors_publisher.send(zmq::message_t(payload), zmq::send_flags::none);
+}
+
+void Rover::publishStats(const std::string& payload) {
+    if(!is_remote_enabled) {
+        return;
+    }
+    publish(stats_topic, payload);
+}
+
+void Rover::publish_mission_progress() {
+    if(!is_remote_enabled) {
+        return;
+    }
+
+    // Published on every change, and once per second for the distance to the target
+    const auto progress = mission_.progress();
+    {
+        const std::lock_guard lock(publisher_mutex);
+        const auto now = std::chrono::steady_clock::now();
+        if(progress.revision == published_mission_revision_ && now - last_mission_publish_ < std::chrono::seconds(1)) {
+            return;
+        }
+        published_mission_revision_ = progress.revision;
+        last_mission_publish_ = now;
+    }
+
+    json j = {
+        {"status", to_string(progress.status)},
+        {"current", progress.current},
+        {"total", progress.total},
+        {"distance", progress.distance}
+    };
+    if(progress.target) {
+        j["target"] = {{"x", progress.target->position.x}, {"y", progress.target->position.y}, {"tolerance", progress.target->tolerance}};
+    } else {
+        j["target"] = nullptr;
+    }
+    publish(mission_progress_topic, j.dump());
+}
+
 void Rover::handle_motors_command(const std::string& command) {
     json j = json::parse(command);
 
@@ -375,8 +782,47 @@ void Rover::handle_motors_setup(const std::string& command) {
 
     BOOST_LOG_TRIVIAL(trace) << fmt::format("Motor setup: run={}", ready);
 
-    std::string cmd = fmt::format("<{},{}>\r\n", ready ? "start" : "stop", ready ? 100 : 0);
-    write(reinterpret_cast<uint8_t*>(cmd.data()), cmd.length());
+    if(ready) {
+        start_sampling(config.platform.sample_period_ms);
+    } else {
+        stop_sampling();
+    }
+}
+
+void Rover::handle_mission_command(const std::string& command) {
+    json j = json::parse(command);
+
+    if(j.contains("clear") && j["clear"].is_boolean() && j["clear"].get<bool>()) {
+        mission_.clear();
+        return;
+    }
+
+    if(!j.contains("waypoints") || !j["waypoints"].is_array()) {
+        BOOST_LOG_TRIVIAL(error) << "[motor_commands_executor] Invalid mission command. Expected waypoints";
+        return;
+    }
+
+    std::vector<Waypoint> waypoints;
+    for(const auto& wp : j["waypoints"]) {
+        if(!wp.contains("x") || !wp.contains("y") || !wp["x"].is_number() || !wp["y"].is_number()) {
+            BOOST_LOG_TRIVIAL(error) << "[motor_commands_executor] Invalid mission command. Expected x and y as numbers";
+            return;
+        }
+        double tolerance = mission_.default_tolerance();
+        if(wp.contains("tolerance") && wp["tolerance"].is_number()) {
+            tolerance = wp["tolerance"].get<double>();
+        }
+        waypoints.push_back({{wp["x"].get<double>(), wp["y"].get<double>()}, tolerance});
+    }
+
+    const bool append = j.contains("append") && j["append"].is_boolean() && j["append"].get<bool>();
+    BOOST_LOG_TRIVIAL(trace) << fmt::format("Mission command: {} waypoints, append={}", waypoints.size(), append);
+
+    if(append) {
+        mission_.append_waypoints(waypoints);
+    } else {
+        mission_.set_waypoints(std::move(waypoints));
+    }
 }
 
 void Rover::motor_commands_executor() {
@@ -399,6 +845,8 @@ void Rover::motor_commands_executor() {
             handle_tilt_motor_command(recv_msgs[1].to_string());
         } else if(topic == motors_setup_topic) {
             handle_motors_setup(recv_msgs[1].to_string());
+        } else if(topic == mission_topic) {
+            handle_mission_command(recv_msgs[1].to_string());
         } else {
             BOOST_LOG_TRIVIAL(warning) << fmt::format("[motor_commands_executor] Unknown topic: {}", topic);
             continue;
@@ -455,7 +903,7 @@ void Rover::async_read()
                 BOOST_LOG_TRIVIAL(trace) << fmt::format("[serial-connection.async_read] read_completion_handler: Operation aborted");
             }
         } else {
-            handle_read_packet(read_serial_buffer, bytes_transferred);
+            handle_read_packet(bytes_transferred);
         }
 
         if(!error || error == boost::asio::error::operation_aborted) {
@@ -463,16 +911,17 @@ void Rover::async_read()
         }
     };
 
-    boost::asio::async_read_until(
-        serial_port,
-        read_serial_buffer,
-        "\r\n",
+    // Lines and binary packets are told apart by the decoder, see handle_read_packet
+    serial_port.async_read_some(
+        boost::asio::buffer(read_serial_buffer),
         read_completion_handler
     );
 }
 
 void Rover::write(uint8_t *data, std::size_t nr_bytes_to_write)
 {
+    // Commands come from the navigator, the remote API and the watchdog
+    const std::lock_guard lock(write_mutex);
     boost::system::error_code erc;
     size_t bytes_transferred = boost::asio::write(serial_port, boost::asio::buffer(data, nr_bytes_to_write), erc);
     (void)bytes_transferred;
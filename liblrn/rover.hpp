@@ -5,7 +5,26 @@
 #include <regex>
 #include <atomic>
 #include <array>
+#include <chrono>
+#include <mutex>
+#include <numbers>
+#include <utility>
+#include <vector>
 #include <liblrn/rover-config.hpp>
+#include <liblrn/geometry.hpp>
+#include <liblrn/kinematics.hpp>
+#include <liblrn/mission.hpp>
+#include <liblrn/pose-estimator.hpp>
+#include <liblrn/gyro-bias.hpp>
+#include <liblrn/attitude-filter.hpp>
+#include <liblrn/seqlock.hpp>
+#include <liblrn/ir-conversion.hpp>
+#include <liblrn/pose-history.hpp>
+#include <liblrn/sensor-clock.hpp>
+#include <liblrn/sensor-stream.hpp>
+#include <liblrn/motor-model.hpp>
+#include <liblrn/yaw-rate-controller.hpp>
+#include <liblrn/velocity-profiler.hpp>
 
 #include <boost/asio.hpp>
 #include <boost/asio/serial_port_base.hpp>
@@ -14,20 +33,13 @@
 
 namespace lrn {
 
-struct Vec2 {
-    double x, y;
-};
-
 struct SensorReading {
     std::array<std::optional<double>, 3> ir;
     std::array<std::optional<double>, 3> acc;
     std::array<std::optional<double>, 3> gyro;
     std::optional<double> ultrasonic;
-};
-
-struct RobotState {
-    Vec2 pos;
-    double theta;
+    std::optional<double> temperature;              // IMU die temperature (°C)
+    std::chrono::steady_clock::time_point stamp;    // acquisition time on the host clock
 };
 
 enum DriveState {
@@ -36,20 +48,41 @@ enum DriveState {
 };
 
 constexpr std::size_t rover_packet_max = 256;
-constexpr std::string_view data_regex = R"(<(ir|acc|gyr),([0-9]+),([\-?0-9\.,]+)>\r?\n?)";
+constexpr std::string_view data_regex = R"(<(ir|acc|gyr|temp|time),([0-9]+),([\-?0-9\.,]+)>\r?\n?)";
 
 constexpr std::string_view motors_setup_topic = "motors-setup";
 constexpr std::string_view motors_commands_topic = "motors-commands";
 constexpr std::string_view tilt_motor_command_topic = "tilt-motor-command";
+constexpr std::string_view mission_topic = "mission-waypoints";
+
+constexpr std::string_view sensors_topic = "lunar-rover-sensors";
+constexpr std::string_view mission_progress_topic = "lunar-rover-mission";
+constexpr std::string_view stats_topic = "lunar-rover-stats";
+
+constexpr std::size_t ir_sensors_count = 3;
+constexpr double ir_sensors_theta_start = 30.0 * std::numbers::pi / 180.0;
+constexpr double ir_sensors_delta = 30.0 * std::numbers::pi / 180.0;
+constexpr double ir_max_range = 0.8;
+
+struct IrObservation {
+    Vec2 point;     // obstacle in the current body frame (m)
+    double range;   // measured range (m)
+};
+using IrObservations = std::array<std::optional<IrObservation>, ir_sensors_count>;
+
+constexpr std::size_t pose_history_capacity = 512;
+
+// Wheel profiles played by the firmware (<wp> and <wr> frames, profile_rvr.h)
+constexpr std::size_t wheel_profile_max_steps = 8;
+constexpr int wheel_profile_min_step_ms = 10;
+constexpr int wheel_profile_max_step_ms = 1000;
+constexpr int wheel_ramp_min_rate = 50;         // duty/s
+constexpr int wheel_ramp_max_rate = 25500;      // full scale in one 10 ms firmware tick
 
 constexpr auto BMI323_ACCEL_SCALE_4G = 8.19;
 constexpr auto BMI323_GYRO_SCALE_1000DPS = 32.768;
-
-typedef struct{
-  long int x;    // ADC value for the corresponding distance  (mm)
-  long int m;    // slope between current ADC value and the next one
-  long int mm;   // distance in mm from the sensor
-} LUT;
+constexpr auto BMI323_TEMPERATURE_SCALE = 512.0;     // LSB/°C, 0 at 23 °C
+constexpr auto BMI323_TEMPERATURE_OFFSET = 23.0;
 
 typedef struct{
   float x;    // ADC value for the corresponding distance  (mm)
@@ -57,21 +90,6 @@ typedef struct{
   float mm;   // distance in mm from the sensor
 } FLUT;
 
-constexpr size_t LUT_SIZE = 11;
-constexpr LUT ir_lut_values[LUT_SIZE] = {
-  {108, 17653, 800},  // slope: 17.2414
-  {113,  7475, 700},  // slope: 7.2988
-  {127, 10129, 600},  // slope: 9.8911
-  {138,  4212, 500},  // slope: 4.1126
-  {162,  2425, 400},  // slope: 2.3689
-  {204,  1281, 300},  // slope: 1.2508
-  {283,   463, 200},  // slope: 0.4528
-  {504,   193, 100},  // slope: 0.1885
-  {557,   190,  90},  // slope: 0.1861
-  {610,   183,  80},  // slope: 0.1792
-  {667,     0,  70}
-};
-
 //// Duty-Cycle	Distância (m)	Velocidade(m/s)
 //constexpr FLUT v_lut_values[] = {
 //    {0.15, 	0.81,	0.162},
@@ -112,13 +130,60 @@ public:
     SensorReading readSensors();
 
     RobotState getState();
+    PoseEstimate getPoseEstimate();
+    std::optional<RobotState> getStateAt(std::chrono::steady_clock::time_point stamp);
+
+    /**
+     * @brief Last IR readings as points in the current body frame, projected from the pose at acquisition time.
+     */
+    IrObservations readObstacles();
 
     Vec2 getGoalPosition();
 
+    /**
+     * @brief Drives at (v, w); with rover.yaw_rate enabled the turn rate is then held by the gyro loop.
+     *
+     * With rover.profiler enabled (v, w) is the target of the velocity
+     * profiler, reached under its acceleration and jerk limits; callers must
+     * repeat it within command_timeout_ms or the rover ramps down to a stop.
+     */
     void drive(double v, double w);
     void tilt(double theta);
 
+    /**
+     * @brief Open-loop wheel speeds, releases the yaw rate loop.
+     */
     void driveWheels(double wl, double wr);
+    void stopWheels();
+
+    /**
+     * @brief Uploads wheel speeds (rad/s) that the firmware holds for step each, the last one is kept.
+     *
+     * Releases the yaw rate loop. The watchdog counts from the end of the
+     * profile; drive calls before then cancel it. False when the profile does
+     * not fit a frame.
+     */
+    bool uploadWheelProfile(const std::vector<WheelSpeeds<double>>& setpoints, std::chrono::milliseconds step);
+
+    /**
+     * @brief Ramps the wheels to (wl, wr) rad/s on the firmware, the larger change at acceleration rad/s^2.
+     */
+    bool rampWheels(double wl, double wr, double acceleration);
+
+    YawRateStatistics yawRateStatistics() const { return yaw_rate_controller_.statistics(); }
+
+    /**
+     * @brief Fits the wheel motor models by stepping the duty of one wheel at a time and measuring the yaw rate.
+     *
+     * Blocks for several minutes with the rover spinning in place; needs room
+     * around it. Returns false when interrupted by stop() or when a table
+     * cannot be fitted, the previous models are kept in that case.
+     */
+    bool calibrateMotors();
+
+    Mission& mission() { return mission_; }
+
+    void publishStats(const std::string& payload);
 
 private:
     void set_connection_parameters(const std::string& port_name, std::uint32_t baudrate, boost::asio::serial_port_base::parity::type parity, boost::asio::serial_port_base::stop_bits::type stop_bits);
@@ -126,8 +191,12 @@ private:
     void close_connection();
     void async_read();
     void write(std::uint8_t *data, std::size_t nr_bytes_to_write);
+    std::mutex write_mutex;
 
-    void handle_read_packet(boost::asio::streambuf &buffer, std::size_t bytes_transferred);
+    void handle_read_packet(std::size_t bytes_transferred);
+    void handle_sensor_line(std::string_view line);
+    void handle_sensor_packet(const SensorPacket& packet);
+    void publish_sensors();
     void handle_read_error(boost::system::error_code error, std::size_t bytes_transferred);
 
     void start_async_read();
@@ -147,7 +216,8 @@ private:
     boost::asio::deadline_timer read_interbytedeadline_timer_;
     boost::posix_time::milliseconds read_interbytedeadline_expiry_time {10};
 
-    boost::asio::streambuf read_serial_buffer;
+    rover_com_buffer read_serial_buffer;
+    SensorStreamDecoder sensor_stream_;
 
     std::string port_name_;
     boost::asio::serial_port_base::baud_rate baudrate_;
@@ -161,6 +231,7 @@ private:
     void handle_ir_sensors_values(std::vector<double> values);
     void handle_acc_sensors_values(std::vector<double> values);
     void handle_gyro_sensors_values(std::vector<double> values);
+    void handle_temperature_values(std::vector<double> values);
     void handle_sensors_value(const std::string &sensor, std::vector<double> values);
 
     // Remote API
@@ -174,9 +245,60 @@ private:
     void handle_motors_command(const std::string& command);
     void handle_tilt_motor_command(const std::string& command);
     void handle_motors_setup(const std::string& command);
-
-    // Last sensors readings
+    void handle_mission_command(const std::string& command);
+
+    std::mutex publisher_mutex;
+    void publish(std::string_view topic, const std::string& payload);
+
+    // Mission
+    Mission mission_;
+    std::uint64_t published_mission_revision_ = 0;
+    std::chrono::steady_clock::time_point last_mission_publish_;
+    void publish_mission_progress();
+
+    // Dead reckoning, stepped on the I/O thread and read lock-free by the navigators
+    PoseEstimator estimator_;
+    GyroBiasEstimator gyro_bias_;
+    AttitudeFilter attitude_filter_;
+    SeqLock<PoseEstimate> pose_;
+    SeqLock<Twist> commanded_twist_;
+    PoseHistory pose_history_ {pose_history_capacity};
+    SensorClock sensor_clock_;
+    std::chrono::steady_clock::time_point sample_stamp_;    // acquisition time of the line being handled
+    void set_commanded_wheels(double wl, double wr);
+
+    MotorModel motor_model_;
+    YawRateController yaw_rate_controller_;
+    std::mutex yaw_rate_mutex_;
+    void release_yaw_rate();
+    void command_wheels(double wl, double wr);
+    void drive_twist(double v, double w);
+
+    VelocityProfiler profiler_;
+    std::mutex profiler_mutex_;
+    std::thread profiler_thread_;
+    void run_profiler();
+    void release_profiler();
+    bool hold_wheel_duty(int dl, int dr, std::chrono::milliseconds duration);
+
+    // Wheel command stream: unchanged duties are not resent until the keepalive is due
+    std::mutex wheel_command_mutex_;
+    std::optional<std::pair<int, int>> sent_duty_;
+    std::chrono::steady_clock::time_point sent_duty_stamp_;
+    std::chrono::milliseconds firmware_period_ {0};     // sensor period last requested with <start,N>
+    std::uint64_t wheel_frames_sent_ = 0;
+    std::uint64_t wheel_frames_suppressed_ = 0;
+    std::chrono::steady_clock::time_point wheel_stats_stamp_;
+    void write_wheel_duty(int dl, int dr, bool force = false);
+    std::pair<int, int> wheel_duty(double wl, double wr);
+    void write_wheel_profile(std::string frame, std::pair<int, int> last, std::chrono::steady_clock::duration duration);
+    std::chrono::steady_clock::duration keepalive_period() const;
+    void start_sampling(int period_ms);
+    void stop_sampling();
+
+    // Last sensors readings, assembled on the I/O thread and published whole to the other threads
     SensorReading last_reading;
+    SeqLock<SensorReading> reading_;
 };
    
 }
\ No newline at end of file
@@ -0,0 +1,213 @@
+#pragma once
+
+// Scalar type of the per-sample kernels (estimator, kinematics, IR conversion,
+// navigator math). Builds pick it with the lrn_SCALAR_TYPE CMake option:
+// double (default), float, or q16 (16.16 fixed point).
+
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+namespace lrn {
+
+/**
+ * @brief Signed 16.16 fixed-point number.
+ *
+ * Range is about +-32768 with a resolution of 1/65536. Products and quotients
+ * are computed in 64 bits and rounded; the elementary functions below are
+ * integer-only approximations good to about 1e-3.
+ */
+class Q16 {
+public:
+    static constexpr int fraction_bits = 16;
+    static constexpr std::int32_t one_raw = std::int32_t{1} << fraction_bits;
+
+    constexpr Q16() = default;
+
+    template<class A>
+        requires std::is_arithmetic_v<A>
+    constexpr explicit Q16(A value) {
+        if constexpr (std::is_floating_point_v<A>) {
+            // Saturate before the cast, which is undefined out of range; NaN maps to 0
+            const double scaled = static_cast<double>(value) * one_raw;
+            if(scaled != scaled) {
+                raw_ = 0;
+            } else if(scaled >= static_cast<double>(std::numeric_limits<std::int32_t>::max())) {
+                raw_ = std::numeric_limits<std::int32_t>::max();
+            } else if(scaled <= static_cast<double>(std::numeric_limits<std::int32_t>::min())) {
+                raw_ = std::numeric_limits<std::int32_t>::min();
+            } else {
+                raw_ = saturate(static_cast<std::int64_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5));
+            }
+        } else {
+            raw_ = saturate(static_cast<std::int64_t>(value) * one_raw);
+        }
+    }
+
+    static constexpr Q16 from_raw(std::int32_t raw) {
+        Q16 q;
+        q.raw_ = raw;
+        return q;
+    }
+
+    constexpr std::int32_t raw() const { return raw_; }
+
+    constexpr explicit operator double() const { return static_cast<double>(raw_) / one_raw; }
+    constexpr explicit operator float() const { return static_cast<float>(raw_) / static_cast<float>(one_raw); }
+
+    constexpr Q16 operator-() const { return from_raw(-raw_); }
+
+    friend constexpr Q16 operator+(Q16 a, Q16 b) { return from_raw(saturate(std::int64_t{a.raw_} + b.raw_)); }
+    friend constexpr Q16 operator-(Q16 a, Q16 b) { return from_raw(saturate(std::int64_t{a.raw_} - b.raw_)); }
+    friend constexpr Q16 operator*(Q16 a, Q16 b) {
+        return from_raw(saturate((std::int64_t{a.raw_} * b.raw_ + (std::int64_t{1} << (fraction_bits - 1))) >> fraction_bits));
+    }
+    friend constexpr Q16 operator/(Q16 a, Q16 b) {
+        if(b.raw_ == 0) {
+            return from_raw(a.raw_ < 0 ? std::numeric_limits<std::int32_t>::min() : std::numeric_limits<std::int32_t>::max());
+        }
+        return from_raw(saturate((std::int64_t{a.raw_} * one_raw) / b.raw_));
+    }
+
+    constexpr Q16& operator+=(Q16 b) { return *this = *this + b; }
+    constexpr Q16& operator-=(Q16 b) { return *this = *this - b; }
+    constexpr Q16& operator*=(Q16 b) { return *this = *this * b; }
+    constexpr Q16& operator/=(Q16 b) { return *this = *this / b; }
+
+    friend constexpr auto operator<=>(Q16 a, Q16 b) = default;
+
+private:
+    static constexpr std::int32_t saturate(std::int64_t v) {
+        if(v > std::numeric_limits<std::int32_t>::max()) {
+            return std::numeric_limits<std::int32_t>::max();
+        }
+        if(v < std::numeric_limits<std::int32_t>::min()) {
+            return std::numeric_limits<std::int32_t>::min();
+        }
+        return static_cast<std::int32_t>(v);
+    }
+
+    std::int32_t raw_ = 0;
+};
+
+template<class T>
+concept Scalar = std::floating_point<T> || std::same_as<T, Q16>;
+
+#if defined(LRN_SCALAR_Q16)
+using real = Q16;
+#elif defined(LRN_SCALAR_FLOAT)
+using real = float;
+#else
+using real = double;
+#endif
+
+namespace math {
+
+template<std::floating_point T> inline T abs(T x) { return std::abs(x); }
+template<std::floating_point T> inline T sqrt(T x) { return std::sqrt(x); }
+template<std::floating_point T> inline T sin(T x) { return std::sin(x); }
+template<std::floating_point T> inline T cos(T x) { return std::cos(x); }
+template<std::floating_point T> inline T atan2(T y, T x) { return std::atan2(y, x); }
+template<std::floating_point T> inline T exp(T x) { return std::exp(x); }
+template<std::floating_point T> inline T hypot(T x, T y) { return std::hypot(x, y); }
+
+inline Q16 abs(Q16 x) { return x < Q16{} ? -x : x; }
+
+inline Q16 sqrt(Q16 x) {
+    if(!(Q16{} < x)) {
+        return Q16{};
+    }
+    // Bitwise integer square root of raw << 16, which is the raw result
+    std::uint64_t n = static_cast<std::uint64_t>(x.raw()) << Q16::fraction_bits;
+    std::uint64_t r = 0;
+    std::uint64_t bit = std::uint64_t{1} << 62;
+    while(bit > n) {
+        bit >>= 2;
+    }
+    while(bit != 0) {
+        if(n >= r + bit) {
+            n -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return Q16::from_raw(static_cast<std::int32_t>(r));
+}
+
+inline Q16 sin(Q16 x) {
+    constexpr std::int64_t pi_raw = 205887;     // pi * 65536
+    constexpr std::int64_t two_pi_raw = 411775;
+    std::int64_t a = x.raw() % two_pi_raw;
+    if(a > pi_raw) {
+        a -= two_pi_raw;
+    } else if(a < -pi_raw) {
+        a += two_pi_raw;
+    }
+    // Parabola through 0, +-pi/2, +-pi, then one refinement step
+    const Q16 t = Q16::from_raw(static_cast<std::int32_t>(a));
+    const Q16 b {4.0 / std::numbers::pi};
+    const Q16 c {-4.0 / (std::numbers::pi * std::numbers::pi)};
+    const Q16 y = b * t + c * t * abs(t);
+    return Q16 {0.225} * (y * abs(y) - y) + y;
+}
+
+inline Q16 cos(Q16 x) {
+    return sin(x + Q16 {std::numbers::pi / 2.0});
+}
+
+inline Q16 atan2(Q16 y, Q16 x) {
+    const Q16 zero {};
+    const Q16 ax = abs(x);
+    const Q16 ay = abs(y);
+    if(!(zero < ax) && !(zero < ay)) {
+        return zero;
+    }
+    // atan on [0, 1], then the octant
+    const bool swap = ax < ay;
+    const Q16 z = swap ? ax / ay : ay / ax;
+    const Q16 quarter_pi {std::numbers::pi / 4.0};
+    Q16 angle = quarter_pi * z - z * (z - Q16 {1}) * (Q16 {0.2447} + Q16 {0.0663} * z);
+    if(swap) {
+        angle = Q16 {std::numbers::pi / 2.0} - angle;
+    }
+    if(x < zero) {
+        angle = Q16 {std::numbers::pi} - angle;
+    }
+    return y < zero ? -angle : angle;
+}
+
+inline Q16 exp(Q16 x) {
+    // 2^(x log2 e), integer part as a shift and a cubic for the fraction
+    const Q16 t = x * Q16 {std::numbers::log2e};
+    const std::int32_t n = t.raw() >> Q16::fraction_bits;    // floor
+    if(n >= 14) {
+        return Q16::from_raw(std::numeric_limits<std::int32_t>::max());
+    }
+    if(n < -Q16::fraction_bits) {
+        return Q16 {};
+    }
+    const Q16 f = Q16::from_raw(t.raw() & (Q16::one_raw - 1));
+    const Q16 p = Q16 {1} + f * (Q16 {0.6951} + f * (Q16 {0.2262} + f * Q16 {0.0782}));
+    return Q16::from_raw(n >= 0 ? p.raw() << n : p.raw() >> -n);
+}
+
+inline Q16 hypot(Q16 x, Q16 y) {
+    // Scaled so the squares cannot overflow the 16 integer bits
+    const Q16 m = abs(x) < abs(y) ? abs(y) : abs(x);
+    if(!(Q16{} < m)) {
+        return Q16{};
+    }
+    const Q16 a = x / m;
+    const Q16 b = y / m;
+    return m * sqrt(a * a + b * b);
+}
+
+} // namespace math
+
+} // namespace lrn
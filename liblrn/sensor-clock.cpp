@@ -0,0 +1,44 @@
+#include <liblrn/sensor-clock.hpp>
+
+#include <algorithm>
+
+namespace lrn {
+
+namespace {
+// Offset relaxation per sample, covers crystal drift at the IMU sample rates
+constexpr auto drift_allowance = std::chrono::microseconds(20);
+
+// IR and temperature samples are stamped ahead of the IMU FIFO frames sent
+// after them; a step back by more than this is an MCU restart (2 s)
+constexpr std::int32_t max_reorder_ticks = 2 * 25600;
+}
+
+SensorClock::clock::time_point SensorClock::to_host(std::uint32_t ticks, clock::time_point received) {
+    std::int64_t sample = unwrapped_;
+    if(last_ticks_) {
+        const auto delta = static_cast<std::int32_t>(ticks - *last_ticks_);
+        if(delta >= 0) {
+            unwrapped_ += delta;
+            last_ticks_ = ticks;
+            sample = unwrapped_;
+        } else if(delta >= -max_reorder_ticks) {
+            // Older than the newest sample, the unwrap stays on the newest
+            sample = unwrapped_ + delta;
+        } else {
+            // Counter went backwards, the MCU restarted
+            unwrapped_ = 0;
+            last_ticks_ = ticks;
+            offset_.reset();
+            sample = 0;
+        }
+    } else {
+        last_ticks_ = ticks;
+    }
+
+    const auto sensor_time = std::chrono::duration_cast<clock::duration>(tick_numerator * sample / tick_denominator);
+    const auto offset = received - clock::time_point{} - sensor_time;
+    offset_ = offset_ ? std::min(*offset_ + drift_allowance, offset) : offset;
+    return clock::time_point{} + sensor_time + *offset_;
+}
+
+} // namespace lrn
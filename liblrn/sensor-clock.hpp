@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace lrn {
+
+/**
+ * @brief Maps the BMI323 sensor time reported by the MCU to the host clock.
+ *
+ * The offset between the clocks is the smallest (receive time - sensor time)
+ * seen so far, i.e. the sample that crossed the serial link fastest. It is
+ * relaxed by a small amount per sample so clock drift is followed. The 32-bit
+ * counter is unwrapped on the newest sample. Samples up to two seconds older
+ * (IMU FIFO frames sent after an IR packet) are mapped relative to it; a
+ * larger jump backwards is an MCU reset and restarts the mapping.
+ */
+class SensorClock {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // BMI323 sensor time resolution, 39.0625 us
+    static constexpr std::chrono::nanoseconds tick_numerator {390625};
+    static constexpr std::int64_t tick_denominator = 10;
+
+    clock::time_point to_host(std::uint32_t ticks, clock::time_point received);
+
+private:
+    std::optional<std::uint32_t> last_ticks_;
+    std::int64_t unwrapped_ = 0;
+    std::optional<clock::duration> offset_;
+};
+
+} // namespace lrn
@@ -0,0 +1,127 @@
+#include <liblrn/sensor-stream.hpp>
+
+namespace lrn {
+
+namespace {
+
+std::uint16_t read_u16(const std::uint8_t* p) {
+    return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+std::int16_t read_i16(const std::uint8_t* p) {
+    return static_cast<std::int16_t>(read_u16(p));
+}
+
+std::uint32_t read_u32(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(read_u16(p)) | (static_cast<std::uint32_t>(read_u16(p + 2)) << 16);
+}
+
+SensorPacket decode_sample(const std::uint8_t* payload) {
+    SensorPacket packet;
+    for(std::size_t i = 0; i < 3; i++) {
+        packet.ir[i] = read_u16(payload + 2 * i);
+        packet.acc[i] = read_i16(payload + 6 + 2 * i);
+        packet.gyr[i] = read_i16(payload + 12 + 2 * i);
+    }
+    packet.temperature = read_i16(payload + 18);
+    packet.sensor_time = read_u32(payload + 20);
+    return packet;
+}
+
+SensorPacket decode_imu(const std::uint8_t* payload) {
+    SensorPacket packet;
+    packet.type = sensor_packet_type_imu;
+    for(std::size_t i = 0; i < 3; i++) {
+        packet.acc[i] = read_i16(payload + 2 * i);
+        packet.gyr[i] = read_i16(payload + 6 + 2 * i);
+    }
+    packet.sensor_time = read_u32(payload + 12);
+    return packet;
+}
+
+SensorPacket decode_ir(const std::uint8_t* payload) {
+    SensorPacket packet;
+    packet.type = sensor_packet_type_ir;
+    for(std::size_t i = 0; i < 3; i++) {
+        packet.ir[i] = read_u16(payload + 2 * i);
+    }
+    packet.sensor_time = read_u32(payload + 6);
+    return packet;
+}
+
+SensorPacket decode_temperature(const std::uint8_t* payload) {
+    SensorPacket packet;
+    packet.type = sensor_packet_type_temperature;
+    packet.temperature = read_i16(payload);
+    packet.sensor_time = read_u32(payload + 2);
+    return packet;
+}
+
+} // namespace
+
+void SensorStreamDecoder::feed(std::span<const std::uint8_t> bytes, const LineHandler& on_line, const PacketHandler& on_packet) {
+    pending_.insert(pending_.end(), bytes.begin(), bytes.end());
+
+    std::size_t i = 0;
+    while(i < pending_.size()) {
+        const std::uint8_t byte = pending_[i];
+        if(byte == sensor_packet_sync0) {
+            if(pending_.size() - i < 2) {
+                break;
+            }
+            if(pending_[i + 1] == sensor_packet_sync1) {
+                if(pending_.size() - i < sensor_packet_header) {
+                    break;
+                }
+                const std::uint8_t type = pending_[i + 2];
+                const std::size_t length = pending_[i + 3];
+                const std::size_t size = sensor_packet_header + length + 2;
+                if(pending_.size() - i < size) {
+                    break;
+                }
+
+                std::uint8_t a = 0;
+                std::uint8_t b = 0;
+                for(std::size_t k = i + 2; k < i + sensor_packet_header + length; k++) {
+                    a = static_cast<std::uint8_t>(a + pending_[k]);
+                    b = static_cast<std::uint8_t>(b + a);
+                }
+                if(a == pending_[i + size - 2] && b == pending_[i + size - 1]) {
+                    // A line cut short by the packet was noise
+                    line_.clear();
+                    const std::uint8_t* payload = &pending_[i + sensor_packet_header];
+                    if(type == sensor_packet_type_sample && length == sensor_packet_sample_payload) {
+                        packets_++;
+                        on_packet(decode_sample(payload));
+                    } else if(type == sensor_packet_type_imu && length == sensor_packet_imu_payload) {
+                        packets_++;
+                        on_packet(decode_imu(payload));
+                    } else if(type == sensor_packet_type_ir && length == sensor_packet_ir_payload) {
+                        packets_++;
+                        on_packet(decode_ir(payload));
+                    } else if(type == sensor_packet_type_temperature && length == sensor_packet_temperature_payload) {
+                        packets_++;
+                        on_packet(decode_temperature(payload));
+                    }
+                    i += size;
+                    continue;
+                }
+                checksum_errors_++;
+            }
+        }
+
+        i++;
+        if(byte == '\n') {
+            if(!line_.empty() && line_.back() == '\r') {
+                line_.pop_back();
+            }
+            on_line(line_);
+            line_.clear();
+        } else if(line_.size() < sensor_line_max) {
+            line_.push_back(static_cast<char>(byte));
+        }
+    }
+    pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(i));
+}
+
+} // namespace lrn
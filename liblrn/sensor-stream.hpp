@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lrn {
+
+// Binary sensor packet of the firmware (sensor_packet.h), little endian:
+// sync 0xA5 0x5A, type, payload length, payload, checksum A, checksum B.
+// The checksum is the 8-bit Fletcher sum over type, length and payload.
+constexpr std::uint8_t sensor_packet_sync0 = 0xA5;
+constexpr std::uint8_t sensor_packet_sync1 = 0x5A;
+constexpr std::uint8_t sensor_packet_type_sample = 0x01;     // IR, IMU, temperature
+constexpr std::uint8_t sensor_packet_type_imu = 0x02;        // one IMU FIFO frame
+constexpr std::uint8_t sensor_packet_type_ir = 0x03;
+constexpr std::uint8_t sensor_packet_type_temperature = 0x04;
+constexpr std::size_t sensor_packet_header = 4;
+constexpr std::size_t sensor_packet_sample_payload = 24;
+constexpr std::size_t sensor_packet_imu_payload = 16;
+constexpr std::size_t sensor_packet_ir_payload = 10;
+constexpr std::size_t sensor_packet_temperature_payload = 6;
+constexpr std::size_t sensor_line_max = 256;      // longer lines are truncated
+
+struct SensorPacket {
+    std::uint8_t type = sensor_packet_type_sample;      // tells which fields are set
+    std::array<std::uint16_t, 3> ir {};     // raw ADC
+    std::array<std::int16_t, 3> acc {};     // raw BMI323
+    std::array<std::int16_t, 3> gyr {};
+    std::int16_t temperature = 0;
+    std::uint32_t sensor_time = 0;
+};
+
+/**
+ * @brief Splits the serial stream into ASCII lines and binary sensor packets.
+ *
+ * The firmware sends its samples either as "<ir,3,..>..." lines or as binary
+ * packets, and status and error messages as lines in both cases. Bytes are
+ * fed as they arrive; a packet failing its checksum is dropped and the
+ * search for the next one restarts one byte after its sync.
+ */
+class SensorStreamDecoder {
+public:
+    using LineHandler = std::function<void(std::string_view)>;
+    using PacketHandler = std::function<void(const SensorPacket&)>;
+
+    void feed(std::span<const std::uint8_t> bytes, const LineHandler& on_line, const PacketHandler& on_packet);
+
+    std::uint64_t packets() const { return packets_; }
+    std::uint64_t checksum_errors() const { return checksum_errors_; }
+
+private:
+    std::vector<std::uint8_t> pending_;
+    std::string line_;
+    std::uint64_t packets_ = 0;
+    std::uint64_t checksum_errors_ = 0;
+};
+
+} // namespace lrn
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+namespace lrn {
+
+/**
+ * @brief Multi-writer, multi-reader sequence lock for small trivially copyable values.
+ *
+ * Readers never block: the writer bumps the sequence around the copy and
+ * readers retry when it changed under them. The value is kept in atomic words
+ * so a torn read is never a data race, just a retry. Writers are serialised
+ * by a mutex, two interleaved stores would leave the sequence odd and the
+ * readers spinning.
+ */
+template<class T>
+    requires std::is_trivially_copyable_v<T>
+class SeqLock {
+public:
+    SeqLock() { store(T{}); }
+    explicit SeqLock(const T& value) { store(value); }
+
+    void store(const T& value) {
+        std::array<std::uint64_t, word_count> words {};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const std::lock_guard lock(write_mutex_);
+        const std::uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for(std::size_t i = 0; i < word_count; i++) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    T load() const {
+        std::array<std::uint64_t, word_count> words {};
+        std::uint32_t before = 0;
+        std::uint32_t after = 0;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            for(std::size_t i = 0; i < word_count; i++) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while((before & 1u) || before != after);
+
+        T value;
+        std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr std::size_t word_count = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::mutex write_mutex_;
+    std::atomic<std::uint32_t> seq_ {0};
+    std::array<std::atomic<std::uint64_t>, word_count> words_ {};
+};
+
+} // namespace lrn
@@ -0,0 +1,101 @@
+#pragma once
+
+// Minimal 4-lane float batch used by the batch kernels (NEON, SSE2 or scalar fallback)
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LRN_SIMD_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LRN_SIMD_SSE2 1
+#else
+#include <algorithm>
+#include <cmath>
+#endif
+
+#include <cstddef>
+
+namespace lrn::simd {
+
+constexpr std::size_t float_lanes = 4;
+
+#if defined(LRN_SIMD_NEON)
+
+struct f32x4 {
+    float32x4_t v;
+};
+
+inline f32x4 load(const float* p) { return {vld1q_f32(p)}; }
+inline void store(float* p, f32x4 a) { vst1q_f32(p, a.v); }
+inline f32x4 broadcast(float x) { return {vdupq_n_f32(x)}; }
+inline f32x4 operator+(f32x4 a, f32x4 b) { return {vaddq_f32(a.v, b.v)}; }
+inline f32x4 operator-(f32x4 a, f32x4 b) { return {vsubq_f32(a.v, b.v)}; }
+inline f32x4 operator*(f32x4 a, f32x4 b) { return {vmulq_f32(a.v, b.v)}; }
+inline f32x4 min(f32x4 a, f32x4 b) { return {vminq_f32(a.v, b.v)}; }
+inline f32x4 max(f32x4 a, f32x4 b) { return {vmaxq_f32(a.v, b.v)}; }
+inline f32x4 mul_add(f32x4 a, f32x4 b, f32x4 c) { return {vmlaq_f32(c.v, a.v, b.v)}; }
+inline f32x4 rsqrt(f32x4 a) {
+    // Estimate refined with one Newton-Raphson step
+    float32x4_t e = vrsqrteq_f32(a.v);
+    e = vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(a.v, e), e));
+    return {e};
+}
+
+#elif defined(LRN_SIMD_SSE2)
+
+struct f32x4 {
+    __m128 v;
+};
+
+inline f32x4 load(const float* p) { return {_mm_loadu_ps(p)}; }
+inline void store(float* p, f32x4 a) { _mm_storeu_ps(p, a.v); }
+inline f32x4 broadcast(float x) { return {_mm_set1_ps(x)}; }
+inline f32x4 operator+(f32x4 a, f32x4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline f32x4 operator-(f32x4 a, f32x4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline f32x4 operator*(f32x4 a, f32x4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline f32x4 min(f32x4 a, f32x4 b) { return {_mm_min_ps(a.v, b.v)}; }
+inline f32x4 max(f32x4 a, f32x4 b) { return {_mm_max_ps(a.v, b.v)}; }
+inline f32x4 mul_add(f32x4 a, f32x4 b, f32x4 c) { return {_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)}; }
+inline f32x4 rsqrt(f32x4 a) {
+    // Estimate refined with one Newton-Raphson step
+    const __m128 e = _mm_rsqrt_ps(a.v);
+    const __m128 three = _mm_set1_ps(3.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    return {_mm_mul_ps(_mm_mul_ps(half, e), _mm_sub_ps(three, _mm_mul_ps(_mm_mul_ps(a.v, e), e)))};
+}
+
+#else
+
+struct f32x4 {
+    float v[float_lanes];
+};
+
+template<class Op>
+inline f32x4 lanewise(f32x4 a, f32x4 b, Op op) {
+    f32x4 r;
+    for(std::size_t i = 0; i < float_lanes; i++) {
+        r.v[i] = op(a.v[i], b.v[i]);
+    }
+    return r;
+}
+
+inline f32x4 load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+inline void store(float* p, f32x4 a) { for(std::size_t i = 0; i < float_lanes; i++) { p[i] = a.v[i]; } }
+inline f32x4 broadcast(float x) { return {{x, x, x, x}}; }
+inline f32x4 operator+(f32x4 a, f32x4 b) { return lanewise(a, b, [](float x, float y) { return x + y; }); }
+inline f32x4 operator-(f32x4 a, f32x4 b) { return lanewise(a, b, [](float x, float y) { return x - y; }); }
+inline f32x4 operator*(f32x4 a, f32x4 b) { return lanewise(a, b, [](float x, float y) { return x * y; }); }
+inline f32x4 min(f32x4 a, f32x4 b) { return lanewise(a, b, [](float x, float y) { return std::min(x, y); }); }
+inline f32x4 max(f32x4 a, f32x4 b) { return lanewise(a, b, [](float x, float y) { return std::max(x, y); }); }
+inline f32x4 mul_add(f32x4 a, f32x4 b, f32x4 c) { return a * b + c; }
+inline f32x4 rsqrt(f32x4 a) {
+    f32x4 r;
+    for(std::size_t i = 0; i < float_lanes; i++) {
+        r.v[i] = 1.0f / std::sqrt(a.v[i]);
+    }
+    return r;
+}
+
+#endif
+
+} // namespace lrn::simd
@@ -0,0 +1,136 @@
+#include <liblrn/step-monitor.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/log/trivial.hpp>
+#include <fmt/format.h>
+
+namespace lrn {
+
+void StepTimeHistogram::record(std::chrono::microseconds elapsed, bool overrun) {
+    const std::int64_t us = elapsed.count();
+    const auto bucket = std::lower_bound(bucket_bounds_us.begin(), bucket_bounds_us.end(), us) - bucket_bounds_us.begin();
+    counts_[static_cast<std::size_t>(bucket)]++;
+    count_++;
+    total_us_ += us;
+    max_us_ = std::max(max_us_, us);
+    if(overrun) {
+        overruns_++;
+    }
+}
+
+std::int64_t StepTimeHistogram::quantile_us(double q) const {
+    if(count_ == 0) {
+        return 0;
+    }
+    const auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count_)));
+    std::uint64_t seen = 0;
+    for(std::size_t i = 0; i < bucket_bounds_us.size(); i++) {
+        seen += counts_[i];
+        if(seen >= rank) {
+            return std::min(bucket_bounds_us[i], max_us_);
+        }
+    }
+    return max_us_;
+}
+
+StepWatchdog::StepWatchdog(Rover& rover, const ControlLoopConfig& cfg)
+    : rover_(rover)
+    , config(cfg)
+    , period_(cfg.period_ms)
+    , budget_(cfg.budget_ms)
+{}
+
+StepWatchdog::~StepWatchdog() {
+    stop();
+}
+
+void StepWatchdog::start() {
+    {
+        const std::lock_guard lock(mutex_);
+        should_stop_ = false;
+        last_kick_ = std::chrono::steady_clock::now();
+    }
+    watchdog_thread_ = std::thread(&StepWatchdog::run, this);
+}
+
+void StepWatchdog::stop() {
+    {
+        const std::lock_guard lock(mutex_);
+        should_stop_ = true;
+    }
+    wakeup_.notify_all();
+    if(watchdog_thread_.joinable()) {
+        watchdog_thread_.join();
+    }
+}
+
+void StepWatchdog::kick(bool on_time) {
+    unsigned missed = 0;
+    {
+        const std::lock_guard lock(mutex_);
+        last_kick_ = std::chrono::steady_clock::now();
+        stall_missed_ = 0;
+        if(on_time) {
+            consecutive_overruns_ = 0;
+            if(tripped_) {
+                tripped_ = false;
+                BOOST_LOG_TRIVIAL(info) << "[watchdog]: control loop back on time";
+            }
+            return;
+        }
+        consecutive_overruns_++;
+        missed_total_.fetch_add(1, std::memory_order_relaxed);
+        if(tripped_ || consecutive_overruns_ < static_cast<unsigned>(config.max_missed_deadlines)) {
+            return;
+        }
+        tripped_ = true;
+        missed = consecutive_overruns_;
+    }
+    trip(missed);
+}
+
+void StepWatchdog::run() {
+    std::unique_lock lock(mutex_);
+    while(!should_stop_) {
+        wakeup_.wait_for(lock, std::max(period_ / 4, std::chrono::milliseconds(1)));
+        if(should_stop_) {
+            break;
+        }
+        lock.unlock();
+        check();
+        lock.lock();
+    }
+}
+
+void StepWatchdog::check() {
+    unsigned missed = 0;
+    {
+        const std::lock_guard lock(mutex_);
+        const auto since = std::chrono::steady_clock::now() - last_kick_;
+        if(since < period_ + budget_) {
+            return;
+        }
+        // First deadline one period plus the budget after the last step, then one per period
+        const auto stalled = static_cast<unsigned>(1 + (since - period_ - budget_) / period_);
+        if(stalled > stall_missed_) {
+            missed_total_.fetch_add(stalled - stall_missed_, std::memory_order_relaxed);
+            stall_missed_ = stalled;
+        }
+        missed = consecutive_overruns_ + stall_missed_;
+        if(tripped_ || missed < static_cast<unsigned>(config.max_missed_deadlines)) {
+            return;
+        }
+        tripped_ = true;
+    }
+    trip(missed);
+}
+
+void StepWatchdog::trip(unsigned missed) {
+    trips_.fetch_add(1, std::memory_order_relaxed);
+    BOOST_LOG_TRIVIAL(error) << fmt::format("[watchdog]: control loop missed {} deadlines, stopping the wheels", missed);
+    rover_.stopWheels();
+}
+
+} // namespace lrn
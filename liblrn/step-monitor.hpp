@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include <liblrn/rover.hpp>
+#include <liblrn/control-loop-config.hpp>
+
+namespace lrn {
+
+/**
+ * @brief Histogram of navigator step times with fixed, roughly logarithmic buckets.
+ */
+class StepTimeHistogram {
+public:
+    // Upper bounds of the buckets (us), the last bucket collects everything above
+    static constexpr std::array<std::int64_t, 10> bucket_bounds_us = {100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000};
+    static constexpr std::size_t bucket_count = bucket_bounds_us.size() + 1;
+
+    void record(std::chrono::microseconds elapsed, bool overrun);
+
+    const std::array<std::uint64_t, bucket_count>& counts() const { return counts_; }
+    std::uint64_t count() const { return count_; }
+    std::uint64_t overruns() const { return overruns_; }
+    double mean_us() const { return count_ ? static_cast<double>(total_us_) / static_cast<double>(count_) : 0.0; }
+    std::int64_t max_us() const { return max_us_; }
+
+    /**
+     * @brief Upper bound of the bucket holding the given quantile, or the max for the last bucket.
+     */
+    std::int64_t quantile_us(double q) const;
+
+private:
+    std::array<std::uint64_t, bucket_count> counts_ {};
+    std::uint64_t count_ = 0;
+    std::uint64_t overruns_ = 0;
+    std::int64_t total_us_ = 0;
+    std::int64_t max_us_ = 0;
+};
+
+/**
+ * @brief Stops the wheels when the control loop misses its deadlines.
+ *
+ * The executor kicks the watchdog after every step. A deadline is missed when
+ * a step exceeds its budget, or when no step completes within one period plus
+ * the budget (and once more for every further period). After
+ * max_missed_deadlines consecutive misses a stop frame is sent to the rover,
+ * so a stalled loop does not leave the last wheel command running until the
+ * firmware motion timeout. Control resumes with the next on-time step.
+ */
+class StepWatchdog {
+public:
+    StepWatchdog(Rover& rover, const ControlLoopConfig& cfg);
+    ~StepWatchdog();
+
+    void start();
+    void stop();
+
+    void kick(bool on_time);
+
+    std::uint64_t trips() const { return trips_.load(std::memory_order_relaxed); }
+    std::uint64_t missed_deadlines() const { return missed_total_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void check();
+    void trip(unsigned missed);
+
+    Rover& rover_;
+    const ControlLoopConfig& config;
+    const std::chrono::milliseconds period_;
+    const std::chrono::milliseconds budget_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::chrono::steady_clock::time_point last_kick_;
+    unsigned consecutive_overruns_ = 0;
+    unsigned stall_missed_ = 0;
+    bool tripped_ = false;
+
+    std::atomic<std::uint64_t> trips_ {0};
+    std::atomic<std::uint64_t> missed_total_ {0};
+
+    bool should_stop_ = false;
+    std::thread watchdog_thread_;
+};
+
+} // namespace lrn
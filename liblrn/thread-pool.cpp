@@ -0,0 +1,79 @@
+#include <liblrn/thread-pool.hpp>
+
+#include <algorithm>
+
+namespace lrn {
+
+ThreadPool::ThreadPool(std::size_t workers) {
+    threads_.reserve(workers);
+    for(std::size_t i = 0; i < workers; i++) {
+        threads_.emplace_back(&ThreadPool::worker_loop, this, i + 1);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        const std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    for(auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::run_chunk(std::size_t chunk) const {
+    const std::size_t blocks = (job_count_ + job_granularity_ - 1) / job_granularity_;
+    const std::size_t per_chunk = (blocks + concurrency() - 1) / concurrency();
+    const std::size_t begin = std::min(job_count_, chunk * per_chunk * job_granularity_);
+    const std::size_t end = std::min(job_count_, (chunk + 1) * per_chunk * job_granularity_);
+    if(begin < end) {
+        (*job_)(begin, end);
+    }
+}
+
+void ThreadPool::parallel_for(std::size_t count, std::size_t granularity, const RangeFunction& fn) {
+    if(threads_.empty()) {
+        fn(0, count);
+        return;
+    }
+    {
+        const std::lock_guard lock(mutex_);
+        job_ = &fn;
+        job_count_ = count;
+        job_granularity_ = std::max<std::size_t>(granularity, 1);
+        pending_ = threads_.size();
+        generation_++;
+    }
+    start_cv_.notify_all();
+
+    run_chunk(0);
+
+    std::unique_lock lock(mutex_);
+    done_cv_.wait(lock, [this] { return pending_ == 0; });
+    job_ = nullptr;
+}
+
+void ThreadPool::worker_loop(std::size_t chunk) {
+    std::uint64_t seen = 0;
+    while(true) {
+        {
+            std::unique_lock lock(mutex_);
+            start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if(stopping_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        run_chunk(chunk);
+
+        {
+            const std::lock_guard lock(mutex_);
+            pending_--;
+        }
+        done_cv_.notify_one();
+    }
+}
+
+} // namespace lrn
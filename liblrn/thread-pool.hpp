@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lrn {
+
+/**
+ * @brief Fixed set of worker threads for splitting batch computations.
+ *
+ * parallel_for blocks until every chunk is done; the calling thread
+ * processes the first chunk itself.
+ */
+class ThreadPool {
+public:
+    using RangeFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+    explicit ThreadPool(std::size_t workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t concurrency() const { return threads_.size() + 1; }
+
+    /**
+     * @brief Runs fn over [0, count) split in one chunk per thread.
+     * @param granularity chunk boundaries are multiples of this value
+     */
+    void parallel_for(std::size_t count, std::size_t granularity, const RangeFunction& fn);
+
+private:
+    void worker_loop(std::size_t chunk);
+    void run_chunk(std::size_t chunk) const;
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+
+    const RangeFunction* job_ = nullptr;
+    std::size_t job_count_ = 0;
+    std::size_t job_granularity_ = 1;
+    std::uint64_t generation_ = 0;
+    std::size_t pending_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace lrn
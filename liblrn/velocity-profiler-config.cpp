@@ -0,0 +1,26 @@
+#include <liblrn/velocity-profiler-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <string_view>
+
+namespace lrn {
+
+VelocityProfilerConfig tag_invoke( boost::json::value_to_tag< VelocityProfilerConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    VelocityProfilerConfig config;
+    extract_optional( obj, config.enabled, VelocityProfilerConfig::CONFIG_ENABLED);
+    extract_optional( obj, config.period_ms, VelocityProfilerConfig::CONFIG_PERIOD_MS);
+    extract_optional( obj, config.max_linear_acceleration, VelocityProfilerConfig::CONFIG_MAX_LINEAR_ACCELERATION);
+    extract_optional( obj, config.max_linear_jerk, VelocityProfilerConfig::CONFIG_MAX_LINEAR_JERK);
+    extract_optional( obj, config.max_angular_acceleration, VelocityProfilerConfig::CONFIG_MAX_ANGULAR_ACCELERATION);
+    extract_optional( obj, config.max_angular_jerk, VelocityProfilerConfig::CONFIG_MAX_ANGULAR_JERK);
+    extract_optional( obj, config.command_timeout_ms, VelocityProfilerConfig::CONFIG_COMMAND_TIMEOUT_MS);
+
+    return config;
+}
+
+} // namespace lrn
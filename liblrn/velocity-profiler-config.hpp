@@ -0,0 +1,30 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <string_view>
+
+namespace lrn {
+
+class VelocityProfilerConfig
+{
+public:
+    static constexpr std::string_view CONFIG_ENABLED = {"enabled"};
+    static constexpr std::string_view CONFIG_PERIOD_MS = {"period_ms"};
+    static constexpr std::string_view CONFIG_MAX_LINEAR_ACCELERATION = {"max_linear_acceleration"};
+    static constexpr std::string_view CONFIG_MAX_LINEAR_JERK = {"max_linear_jerk"};
+    static constexpr std::string_view CONFIG_MAX_ANGULAR_ACCELERATION = {"max_angular_acceleration"};
+    static constexpr std::string_view CONFIG_MAX_ANGULAR_JERK = {"max_angular_jerk"};
+    static constexpr std::string_view CONFIG_COMMAND_TIMEOUT_MS = {"command_timeout_ms"};
+
+    bool enabled = false;
+    int period_ms = 20;                     // profile update and command period
+    double max_linear_acceleration = 0.5;   // (m/s^2)
+    double max_linear_jerk = 2.0;           // (m/s^3), 0 limits the acceleration only
+    double max_angular_acceleration = 3.0;  // (rad/s^2)
+    double max_angular_jerk = 15.0;         // (rad/s^3), 0 limits the acceleration only
+    int command_timeout_ms = 300;           // the target falls back to standing still without a new command
+};
+
+VelocityProfilerConfig tag_invoke( boost::json::value_to_tag< VelocityProfilerConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
@@ -0,0 +1,86 @@
+#include <liblrn/velocity-profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace lrn {
+
+void ProfiledAxis::step(double target, double max_acceleration, double max_jerk, double dt) {
+    const double error = target - value;
+
+    if(!(max_jerk > 0.0)) {
+        const double change = std::clamp(error, -max_acceleration * dt, max_acceleration * dt);
+        value += change;
+        acceleration = dt > 0.0 ? change / dt : 0.0;
+        return;
+    }
+
+    // Largest acceleration that can still be ramped down to zero in steps of max_jerk dt before
+    // reaching the target: a^2 / 2 jerk + a dt / 2 = |error|
+    const double ramp_down = max_jerk * (std::sqrt(dt * dt / 4.0 + 2.0 * std::abs(error) / max_jerk) - dt / 2.0);
+    const double wanted = std::copysign(std::min(ramp_down, max_acceleration), error);
+    acceleration += std::clamp(wanted - acceleration, -max_jerk * dt, max_jerk * dt);
+    const double next = value + acceleration * dt;
+
+    // Arriving within this step with at most the last step of the ramp down left
+    if((target - next) * error <= 0.0 && std::abs(acceleration) <= max_jerk * dt * (1.0 + 1e-9)) {
+        value = target;
+        acceleration = 0.0;
+        return;
+    }
+    value = next;
+}
+
+VelocityProfiler::VelocityProfiler(const VelocityProfilerConfig& cfg)
+    : config(cfg)
+{}
+
+void VelocityProfiler::set_target(const Twist& target, std::chrono::steady_clock::time_point stamp) {
+    const std::lock_guard lock(mutex_);
+    if(!engaged_) {
+        engaged_ = true;
+        last_step_ = stamp;
+    }
+    target_ = target;
+    target_stamp_ = stamp;
+}
+
+void VelocityProfiler::reset() {
+    const std::lock_guard lock(mutex_);
+    engaged_ = false;
+    target_ = {0.0, 0.0};
+    v_ = {};
+    w_ = {};
+}
+
+std::optional<Twist> VelocityProfiler::step(std::chrono::steady_clock::time_point now) {
+    const std::lock_guard lock(mutex_);
+    if(!engaged_) {
+        return std::nullopt;
+    }
+
+    if(now - target_stamp_ > std::chrono::milliseconds(config.command_timeout_ms)) {
+        target_ = {0.0, 0.0};
+    }
+
+    // A late step must not turn into one large jump
+    const double period = static_cast<double>(config.period_ms) / 1000.0;
+    const double dt = std::clamp(std::chrono::duration<double>(now - last_step_).count(), 0.0, 2.0 * period);
+    last_step_ = now;
+
+    v_.step(target_.v, config.max_linear_acceleration, config.max_linear_jerk, dt);
+    w_.step(target_.w, config.max_angular_acceleration, config.max_angular_jerk, dt);
+
+    const Twist output {v_.value, w_.value};
+    const bool at_rest = std::abs(target_.v) < 1e-9 && std::abs(target_.w) < 1e-9
+        && std::abs(v_.value) < 1e-9 && std::abs(w_.value) < 1e-9;
+    if(at_rest) {
+        // Stopped, the zero command is still returned once so the wheels get it
+        engaged_ = false;
+        v_ = {};
+        w_ = {};
+    }
+    return output;
+}
+
+} // namespace lrn
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+
+#include <liblrn/geometry.hpp>
+#include <liblrn/velocity-profiler-config.hpp>
+
+namespace lrn {
+
+/**
+ * @brief One profiled velocity with its rate of change.
+ */
+struct ProfiledAxis {
+    double value = 0.0;
+    double acceleration = 0.0;
+
+    /**
+     * @brief Moves towards target for dt seconds under the acceleration and jerk limits.
+     *
+     * The acceleration follows sqrt(2 jerk |error|), the largest one that can
+     * still be ramped down to zero by the time the target is reached, so the
+     * velocity arrives without overshoot. A jerk limit of 0 limits the
+     * acceleration only.
+     */
+    void step(double target, double max_acceleration, double max_jerk, double dt);
+};
+
+/**
+ * @brief Shapes (v, w) commands under acceleration and jerk limits.
+ *
+ * set_target() takes the latest command from any source, the navigators or
+ * the remote API, at whatever rate it arrives; step() runs at the control
+ * rate and returns the shaped twist to drive. A target older than
+ * command_timeout_ms is replaced by standing still, the profile then ramps
+ * down and disengages once stopped.
+ */
+class VelocityProfiler {
+public:
+    explicit VelocityProfiler(const VelocityProfilerConfig& cfg);
+
+    void set_target(const Twist& target, std::chrono::steady_clock::time_point stamp);
+
+    /**
+     * @brief Drops the profile, e.g. when the wheels are commanded directly; the next one starts from rest.
+     */
+    void reset();
+
+    /**
+     * @brief Advances the profile to now, empty while disengaged.
+     */
+    std::optional<Twist> step(std::chrono::steady_clock::time_point now);
+
+private:
+    const VelocityProfilerConfig& config;
+
+    std::mutex mutex_;
+    bool engaged_ = false;
+    Twist target_ {0.0, 0.0};
+    std::chrono::steady_clock::time_point target_stamp_;
+    std::chrono::steady_clock::time_point last_step_;
+    ProfiledAxis v_;
+    ProfiledAxis w_;
+};
+
+} // namespace lrn
@@ -0,0 +1,29 @@
+#include <liblrn/yaw-rate-controller-config.hpp>
+#include <liblrn/json-extract.hpp>
+
+#include <boost/json/value.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/conversion.hpp>
+#include <string_view>
+
+namespace lrn {
+
+YawRateControllerConfig tag_invoke( boost::json::value_to_tag< YawRateControllerConfig > /*unused*/, boost::json::value const& json_value )
+{
+    boost::json::object const& obj = json_value.as_object();
+    YawRateControllerConfig config;
+    extract_optional( obj, config.enabled, YawRateControllerConfig::CONFIG_ENABLED);
+    extract_optional( obj, config.kp, YawRateControllerConfig::CONFIG_KP);
+    extract_optional( obj, config.ki, YawRateControllerConfig::CONFIG_KI);
+    extract_optional( obj, config.integral_limit, YawRateControllerConfig::CONFIG_INTEGRAL_LIMIT);
+    extract_optional( obj, config.max_correction, YawRateControllerConfig::CONFIG_MAX_CORRECTION);
+    extract_optional( obj, config.max_dt, YawRateControllerConfig::CONFIG_MAX_DT);
+    extract_optional( obj, config.step_threshold, YawRateControllerConfig::CONFIG_STEP_THRESHOLD);
+    extract_optional( obj, config.step_window_ms, YawRateControllerConfig::CONFIG_STEP_WINDOW_MS);
+    extract_optional( obj, config.settle_band, YawRateControllerConfig::CONFIG_SETTLE_BAND);
+    extract_optional( obj, config.stats_period_s, YawRateControllerConfig::CONFIG_STATS_PERIOD_S);
+
+    return config;
+}
+
+} // namespace lrn
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <string_view>
+
+namespace lrn {
+
+class YawRateControllerConfig
+{
+public:
+    static constexpr std::string_view CONFIG_ENABLED = {"enabled"};
+    static constexpr std::string_view CONFIG_KP = {"kp"};
+    static constexpr std::string_view CONFIG_KI = {"ki"};
+    static constexpr std::string_view CONFIG_INTEGRAL_LIMIT = {"integral_limit"};
+    static constexpr std::string_view CONFIG_MAX_CORRECTION = {"max_correction"};
+    static constexpr std::string_view CONFIG_MAX_DT = {"max_dt"};
+    static constexpr std::string_view CONFIG_STEP_THRESHOLD = {"step_threshold"};
+    static constexpr std::string_view CONFIG_STEP_WINDOW_MS = {"step_window_ms"};
+    static constexpr std::string_view CONFIG_SETTLE_BAND = {"settle_band"};
+    static constexpr std::string_view CONFIG_STATS_PERIOD_S = {"stats_period_s"};
+
+    bool enabled = false;
+    double kp = 0.8;                // correction per yaw rate error
+    double ki = 2.0;                // (1/s)
+    double integral_limit = 1.0;    // largest integral correction (rad/s)
+    double max_correction = 1.5;    // largest total correction added to the command (rad/s)
+    double max_dt = 0.1;            // longer gaps between IMU samples are clamped (s)
+    double step_threshold = 0.3;    // reference changes at least this large are measured as steps (rad/s)
+    int step_window_ms = 2000;      // step response observation time
+    double settle_band = 0.05;      // settled within this fraction of the step
+    int stats_period_s = 10;        // tracking error report period
+};
+
+YawRateControllerConfig tag_invoke( boost::json::value_to_tag< YawRateControllerConfig > /*unused*/, boost::json::value const& json_value );
+
+} // namespace lrn
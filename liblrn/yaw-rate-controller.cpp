@@ -0,0 +1,179 @@
+#include <liblrn/yaw-rate-controller.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include <boost/log/trivial.hpp>
+#include <fmt/format.h>
+
+namespace lrn {
+
+namespace {
+constexpr double still_command = 1e-3;
+}
+
+YawRateController::YawRateController(const YawRateControllerConfig& cfg)
+    : config(cfg)
+    , period_start_(std::chrono::steady_clock::now())
+{}
+
+void YawRateController::set_limits(double max_wheel_speed, double wheelbase, double wheel_radius) {
+    const std::lock_guard lock(mutex_);
+    max_wheel_speed_ = max_wheel_speed;
+    wheelbase_ = wheelbase;
+    wheel_radius_ = wheel_radius;
+}
+
+double YawRateController::limit_yaw_rate(double v, double w, bool& saturated) const {
+    // Largest turn rate that keeps both wheels within their speed at this v
+    const double headroom = std::max(0.0, max_wheel_speed_ - std::abs(v) / wheel_radius_);
+    const double w_max = headroom * 2.0 * wheel_radius_ / wheelbase_;
+    saturated = std::abs(w) > w_max;
+    return std::clamp(w, -w_max, w_max);
+}
+
+Twist YawRateController::engage(const Twist& reference) {
+    const std::lock_guard lock(mutex_);
+
+    if(std::abs(reference.v) < still_command && std::abs(reference.w) < still_command) {
+        // Standing still, the loop would only chase gyro noise
+        reference_.reset();
+        integral_ = 0.0;
+        correction_ = 0.0;
+        if(step_) {
+            finish_step();
+        }
+        return reference;
+    }
+
+    const double previous = reference_ ? reference_->w : 0.0;
+    if(std::abs(reference.w - previous) >= config.step_threshold) {
+        if(step_) {
+            finish_step();
+        }
+        step_ = YawRateStep{measured_, reference.w};
+        step_engaged_ = false;
+    }
+    if(reference.w * previous < 0.0) {
+        // Turning the other way, the slip learned for this direction does not apply
+        integral_ = 0.0;
+        correction_ = 0.0;
+    }
+    reference_ = reference;
+
+    bool saturated = false;
+    return {reference.v, limit_yaw_rate(reference.v, reference.w + correction_, saturated)};
+}
+
+void YawRateController::release() {
+    const std::lock_guard lock(mutex_);
+    reference_.reset();
+    integral_ = 0.0;
+    correction_ = 0.0;
+    step_.reset();
+}
+
+std::optional<Twist> YawRateController::update(double yaw_rate, std::chrono::steady_clock::time_point stamp) {
+    const std::lock_guard lock(mutex_);
+    measured_ = yaw_rate;
+    const auto previous_stamp = last_stamp_;
+    last_stamp_ = stamp;
+    if(!reference_) {
+        return std::nullopt;
+    }
+
+    double dt = 0.0;
+    if(previous_stamp) {
+        dt = std::clamp(std::chrono::duration<double>(stamp - *previous_stamp).count(), 0.0, config.max_dt);
+    }
+
+    const Twist reference = *reference_;
+    const double error = reference.w - yaw_rate;
+    const double proportional = config.kp * error;
+    const double integral = std::clamp(integral_ + config.ki * error * dt, -config.integral_limit, config.integral_limit);
+
+    const double wanted = proportional + integral;
+    const double correction = std::clamp(wanted, -config.max_correction, config.max_correction);
+    bool limited = false;
+    const double w = limit_yaw_rate(reference.v, reference.w + correction, limited);
+    const bool saturated = limited || std::abs(wanted) > config.max_correction;
+
+    // Conditional integration: keep the integral while the error pushes further into the limit
+    const double excess = reference.w + wanted - w;
+    if(!saturated || excess * error < 0.0) {
+        integral_ = integral;
+    }
+    correction_ = w - reference.w;
+
+    record(error, saturated, yaw_rate, stamp);
+    return Twist{reference.v, w};
+}
+
+void YawRateController::record(double error, bool saturated, double yaw_rate, std::chrono::steady_clock::time_point stamp) {
+    error_sum_sq_ += error * error;
+    error_max_ = std::max(error_max_, std::abs(error));
+    period_samples_++;
+    if(saturated) {
+        saturated_++;
+    }
+    if(stamp - period_start_ >= std::chrono::seconds(config.stats_period_s)) {
+        last_report_.samples = period_samples_;
+        last_report_.rms_error = std::sqrt(error_sum_sq_ / static_cast<double>(period_samples_));
+        last_report_.max_error = error_max_;
+        last_report_.saturated = saturated_;
+        BOOST_LOG_TRIVIAL(info) << fmt::format("[yaw-rate]: tracking rms {:.3f} rad/s, max {:.3f} rad/s over {} samples, {} saturated, integral {:.3f} rad/s",
+            last_report_.rms_error, last_report_.max_error, last_report_.samples, last_report_.saturated, integral_);
+        period_start_ = stamp;
+        error_sum_sq_ = 0.0;
+        error_max_ = 0.0;
+        period_samples_ = 0;
+        saturated_ = 0;
+    }
+
+    if(!step_) {
+        return;
+    }
+    const double span = step_->target - step_->from;
+    if(std::abs(span) < 1e-9) {
+        step_.reset();
+        return;
+    }
+    if(!step_engaged_) {
+        step_start_ = stamp;
+        step_engaged_ = true;
+    }
+    const double elapsed_ms = std::max(0.0, std::chrono::duration<double, std::milli>(stamp - step_start_).count());
+    const double progress = (yaw_rate - step_->from) / span;
+    if(step_->rise_ms < 0.0 && progress >= 0.9) {
+        step_->rise_ms = elapsed_ms;
+    }
+    step_->overshoot = std::max(step_->overshoot, progress - 1.0);
+    if(std::abs(progress - 1.0) > config.settle_band) {
+        step_->settle_ms = -1.0;
+    } else if(step_->settle_ms < 0.0) {
+        step_->settle_ms = elapsed_ms;
+    }
+    if(elapsed_ms >= config.step_window_ms) {
+        finish_step();
+    }
+}
+
+void YawRateController::finish_step() {
+    const auto& step = *step_;
+    BOOST_LOG_TRIVIAL(info) << fmt::format("[yaw-rate]: step {:.2f} -> {:.2f} rad/s, rise {}, overshoot {:.0f} %, settle {}",
+        step.from, step.target,
+        step.rise_ms < 0.0 ? std::string("not reached") : fmt::format("{:.0f} ms", step.rise_ms),
+        100.0 * step.overshoot,
+        step.settle_ms < 0.0 ? std::string("not settled") : fmt::format("{:.0f} ms", step.settle_ms));
+    step_.reset();
+}
+
+YawRateStatistics YawRateController::statistics() const {
+    const std::lock_guard lock(mutex_);
+    YawRateStatistics stats = last_report_;
+    stats.integral = integral_;
+    return stats;
+}
+
+} // namespace lrn
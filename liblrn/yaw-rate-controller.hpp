@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include <liblrn/geometry.hpp>
+#include <liblrn/yaw-rate-controller-config.hpp>
+
+namespace lrn {
+
+struct YawRateStatistics {
+    std::uint64_t samples = 0;
+    double rms_error = 0.0;         // over the last report period (rad/s)
+    double max_error = 0.0;
+    double integral = 0.0;          // current integral correction (rad/s)
+    std::uint64_t saturated = 0;    // samples with the output at its limit
+};
+
+struct YawRateStep {
+    double from = 0.0;              // measured rate when the step started (rad/s)
+    double target = 0.0;
+    double rise_ms = -1.0;          // to 90 % of the step, negative when never reached
+    double overshoot = 0.0;         // beyond the target, fraction of the step
+    double settle_ms = -1.0;        // last entry into the settle band, negative when never settled
+};
+
+/**
+ * @brief Inner PI loop making the measured yaw rate track the commanded one.
+ *
+ * The reference turn rate is the feed-forward term, mapped to wheel duty by
+ * the motor model like an open-loop command; the loop adds a PI correction of
+ * the gyro rate error on top. The integral is clamped and stops growing while
+ * the output is limited by the wheel speeds (anti-windup).
+ *
+ * engage() and release() come from the navigation thread, update() runs on
+ * the I/O thread with every gyro sample.
+ */
+class YawRateController {
+public:
+    explicit YawRateController(const YawRateControllerConfig& cfg);
+
+    /**
+     * @brief Wheel limits used to bound the output, in rad/s and m.
+     */
+    void set_limits(double max_wheel_speed, double wheelbase, double wheel_radius);
+
+    /**
+     * @brief Sets the reference, returns it with the current correction applied.
+     */
+    Twist engage(const Twist& reference);
+    void release();
+
+    /**
+     * @brief Steps the loop with a measured yaw rate, empty when released.
+     */
+    std::optional<Twist> update(double yaw_rate, std::chrono::steady_clock::time_point stamp);
+
+    YawRateStatistics statistics() const;
+
+private:
+    double limit_yaw_rate(double v, double w, bool& saturated) const;
+    void record(double error, bool saturated, double yaw_rate, std::chrono::steady_clock::time_point stamp);
+    void finish_step();
+
+    const YawRateControllerConfig& config;
+    double max_wheel_speed_ = 0.0;
+    double wheelbase_ = 1.0;
+    double wheel_radius_ = 1.0;
+
+    mutable std::mutex mutex_;
+    std::optional<Twist> reference_;
+    double integral_ = 0.0;
+    double correction_ = 0.0;
+    double measured_ = 0.0;
+    std::optional<std::chrono::steady_clock::time_point> last_stamp_;
+
+    // Tracking report
+    double error_sum_sq_ = 0.0;
+    double error_max_ = 0.0;
+    std::uint64_t period_samples_ = 0;
+    std::uint64_t saturated_ = 0;
+    std::chrono::steady_clock::time_point period_start_;
+    YawRateStatistics last_report_;
+
+    // Step response being observed
+    std::optional<YawRateStep> step_;
+    std::chrono::steady_clock::time_point step_start_;
+    bool step_engaged_ = false;     // the step starts with the first sample after the reference change
+};
+
+} // namespace lrn
@@ -3,88 +3,78 @@
 #include "bmi323.h"
 #include "analog_inputs.h"
 #include "motors_rvr.h"
+#include "profile_rvr.h"
+#include "sensor_packet.h"
+#include "sched_rvr.h"
 
 extern analog_sense_t Sensor[];
 extern bmi323_data_t sensor_data;
 
 const unsigned long DefaultFrequencyMS = 1000;
-unsigned long SampleFrequency_MS;
+unsigned long SampleFrequency_MS = DefaultFrequencyMS;
 unsigned long LastStampReceivingFrame;
 const unsigned long ConsiderMotion = 3;
-const Frame Stop = { CMD_STOP,"stop",2,0,0};
+const uint16_t ImuDefaultPeriodMS = 5;       // 200 Hz, BMI323_FIFO_ODR
+const uint16_t TempDefaultPeriodMS = 1000;
+unsigned long DroppedPackets;     // samples not sent because the TX buffer was full
+const Frame Stop = { CMD_STOP,2,0,0};
 
 
 
-//bool state = false;
-bool SampleSensors = false;
-
-// ISR TIMER 1
-ISR(TIMER1_COMPA_vect) {
-  SampleSensors = true;    // set flag to perform sampling
-}
-
-void timer1_setup (void){
-  cli(); // desabilita interrupções globais
-
-  TCCR1A = 0; // Modo normal
-  TCCR1B = 0;
-
-  // Modo CTC
-  TCCR1B |= (1 << WGM12);
-  // Prescaler 1024
-  TCCR1B |= (1 << CS12) | (1 << CS10);
-
-  // 128 ms com clock de 16MHz: OCR1A = (F_CPU / Prescaler) * Tempo - 1
-  // OCR1A = (16.000.000 / 1024) * 0.128 - 1 ≈ 1999
-  //OCR1A = 1999;
-  OCR1A = 15624;
-
-  // Habilita interrupção
-  TIMSK1 |= (1 << OCIE1A);
-
-  sei(); // habilita interrupções globais
-}
-
-
-void timer1_start(void)
+/*
+* IR period from <start>, also the pace of the speed frame watchdog
+*/
+void sampling_start(void)
 {
-    unsigned int  ms2reg;
-    ms2reg = DefaultFrequencyMS;
-    SampleFrequency_MS = DefaultFrequencyMS;
-    ms2reg = 15625 * ms2reg / 1000 - 1;
+    sampling_start(DefaultFrequencyMS);
 }
 
-void timer1_start(unsigned int time_ms)
+void sampling_start(unsigned int time_ms)
 {
-    unsigned int  ms2reg;
-    ms2reg = time_ms;
     SampleFrequency_MS = time_ms;
-    ms2reg = 15625 * ms2reg / 1000 - 1;
-    OCR1A = (uint16_t)ms2reg;
+    sched_set_period(SENSOR_CHANNEL_IR, time_ms);
+    sched_restart();
+    // Samples queued while stopped would reach the host out of date
+    bmi323_fifo_flush();
 }
 
-void timer1_stop(void)
+void sampling_stop(void)
 {
+    profile_cancel();
     if (motors_in_motion())
         parser_motors(&Stop);
 }
-// --- Simulated sensor reading ---
-void readSensors() {
-
 
-    distance_check();
-    //digitalWrite(8, HIGH);
-    bmi323_read_data_burst();
-    //digitalWrite(8, LOW);
+bool sampling_rates(const Frame* p_frm)
+{
+    if (!sched_load_rates(p_frm))
+        return false;
+    // The FIFO paces the IMU channel, its ODR follows the period
+    uint16_t imu_ms = sched_period(SENSOR_CHANNEL_IMU);
+    if (imu_ms != 0)
+        bmi323_fifo_set_odr(bmi323_odr_for_period(imu_ms));
+    return true;
+}
 
+/*
+* Writes a whole packet, or drops it when the TX buffer has no room for it: the loop never
+* waits on the UART
+*/
+static bool send_packet(const void* packet, uint8_t size) {
+    if (Serial.availableForWrite() < size) {
+        DroppedPackets++;
+        return false;
+    }
+    Serial.write((const uint8_t*)packet, size);
+    return true;
+}
 
-    Serial.print("<ir,3,");
-    Serial.print((Sensor[0].raw));
-    Serial.print(",");
-    Serial.print((Sensor[1].raw));
-    Serial.print(",");
-    Serial.print((Sensor[2].raw));
-    Serial.print("><acc,3,");
+/*
+* One IMU sample, acc, gyr and sensor time
+*/
+static void send_imu_sample(void) {
+#if SENSOR_OUTPUT_ASCII
+    Serial.print("<acc,3,");
     Serial.print(sensor_data.acc_x);
     Serial.print(",");
     Serial.print(sensor_data.acc_y);
@@ -96,29 +86,125 @@ void readSensors() {
     Serial.print(sensor_data.gyr_y);
     Serial.print(",");
     Serial.print(sensor_data.gyr_z);
-    Serial.print("><temp,1,");
-    Serial.print(sensor_data.temperature);
     Serial.print("><time,1,");
     Serial.print(sensor_data.sensor_time);
     Serial.println(">");
+#else
+    imu_packet_t packet;
+    packet.acc[0] = sensor_data.acc_x;
+    packet.acc[1] = sensor_data.acc_y;
+    packet.acc[2] = sensor_data.acc_z;
+    packet.gyr[0] = sensor_data.gyr_x;
+    packet.gyr[1] = sensor_data.gyr_y;
+    packet.gyr[2] = sensor_data.gyr_z;
+    packet.sensor_time = sensor_data.sensor_time;
+    sensor_packet_seal((uint8_t*)&packet, sizeof(packet), SENSOR_PACKET_IMU);
+    send_packet(&packet, sizeof(packet));
+#endif
+}
 
+/*
+* The IR channels alone, stamped in the sensor time base of the IMU samples
+*/
+static void send_ir_sample(void) {
+#if SENSOR_OUTPUT_ASCII
+    Serial.print("<ir,3,");
+    Serial.print((Sensor[0].raw));
+    Serial.print(",");
+    Serial.print((Sensor[1].raw));
+    Serial.print(",");
+    Serial.print((Sensor[2].raw));
+    Serial.print("><time,1,");
+    Serial.print(bmi323_sensor_time_now());
+    Serial.println(">");
+#else
+    ir_packet_t packet;
+    for (uint8_t i = 0; i < 3; i++) {
+        packet.ir[i] = (uint16_t)Sensor[i].raw;
+    }
+    packet.sensor_time = bmi323_sensor_time_now();
+    sensor_packet_seal((uint8_t*)&packet, sizeof(packet), SENSOR_PACKET_IR);
+    send_packet(&packet, sizeof(packet));
+#endif
+}
 
+/*
+* The temperature alone, refreshed by the IMU reads
+*/
+static void send_temp_sample(void) {
+#if SENSOR_OUTPUT_ASCII
+    Serial.print("<temp,1,");
+    Serial.print(sensor_data.temperature);
+    Serial.print("><time,1,");
+    Serial.print(bmi323_sensor_time_now());
+    Serial.println(">");
+#else
+    temp_packet_t packet;
+    packet.temperature = sensor_data.temperature;
+    packet.sensor_time = bmi323_sensor_time_now();
+    sensor_packet_seal((uint8_t*)&packet, sizeof(packet), SENSOR_PACKET_TEMP);
+    send_packet(&packet, sizeof(packet));
+#endif
 }
 
-bool handleSerialInput(String & serialIn) {
-    bool frameReady = false;
-    //Serial.println("handle Serial");
-    if (Serial.available()) {
+static void imu_task(void) {
+    // Polled when the FIFO is not streaming, sent by sensors_update() once read
+    if (!bmi323_fifo_enabled())
+        bmi323_start_burst();
+}
+
+static void ir_task(void) {
+    // Snapshot of what the ADC interrupt left, nothing waits here
+    distance_check();
+    send_ir_sample();
+}
+
+void sensors_setup(void) {
+    sched_attach(SENSOR_CHANNEL_IMU, imu_task, ImuDefaultPeriodMS);
+    sched_attach(SENSOR_CHANNEL_IR, ir_task, DefaultFrequencyMS);
+    sched_attach(SENSOR_CHANNEL_TEMP, send_temp_sample, TempDefaultPeriodMS);
+}
+
+/*
+* Forwards the IMU samples as they are read, never waits. With the FIFO streaming every
+* frame goes out, as many per pass as the TX buffer takes; otherwise the burst started by
+* the IMU task is collected
+*/
+void sensors_update(void) {
+    bool imu_on = sched_period(SENSOR_CHANNEL_IMU) != 0;
+
+    if (bmi323_fifo_enabled()) {
+        bmi323_fifo_update();
+        while ((!imu_on || Serial.availableForWrite() >= (int)sizeof(imu_packet_t)) && bmi323_fifo_next()) {
+            if (imu_on)
+                send_imu_sample();
+        }
+        return;
+    }
+
+    if (bmi323_poll_burst() && imu_on)
+        send_imu_sample();
+}
+
+/*
+* Drains the bytes buffered by the UART RX interrupt into serialIn and stops at the end
+* of a frame, so a whole frame is assembled in one call whatever its length. Bytes after
+* the '\n' stay in the UART buffer for the next call
+*/
+bool handleSerialInput(char* serialIn, uint8_t& length) {
+    while (Serial.available()) {
 
         char c = Serial.read();
-        serialIn += c;
-        //Serial.print(c);
+        if (c == '<' || length >= FRAME_BUFFER_SIZE) {
+            // Start of a frame, whatever was left unterminated before it is dropped
+            length = 0;
+        }
+        serialIn[length++] = c;
         if (c == '\n') {
-            //Serial.println(serialIn);
-            frameReady = true;
+            return true;
         }
     }
-    return frameReady;
+    return false;
 
 }
 
@@ -1,23 +1,25 @@
 #pragma once
 
 #include <Arduino.h>
-#include <Wire.h>
+#include "twi_rvr.h"
 #include "SoftPWM.h"
+#include "parser.h"
 
-void timer1_setup (void);
+void sampling_start(void);
 
-void timer1_start(void);
+void sampling_start(unsigned int time_ms);
 
-void timer1_start(unsigned int time_ms);
+void sampling_stop(void);
 
-void timer1_stop(void);
+bool sampling_rates(const Frame* p_frm);
 
-void readSensors();
+void sensors_setup(void);
 
-bool handleSerialInput(String& serialIn);
+void sensors_update(void);
+
+bool handleSerialInput(char* serialIn, uint8_t& length);
 
 void check_receiving_speed_frames(void);
 
 void ack_receiving_speed_frames(void);
 
-extern bool SampleSensors;
@@ -40,7 +40,15 @@
 #include <stdint.h>
 #include <Arduino.h>
 
+// The ISR walks every channel on each tick. With the wheels on hardware PWM (motors_rvr.h)
+// only the camera servo is left on a Mega
+#ifndef SOFTPWM_MAXCHANNELS
+#if defined(__AVR_ATmega2560__)
+#define SOFTPWM_MAXCHANNELS 4
+#else
 #define SOFTPWM_MAXCHANNELS 20
+#endif
+#endif
 #define SOFTPWM_PWMDEFAULT 0x00
 
 #define SOFTPWM_NORMAL 0
@@ -1,9 +1,19 @@
 #include <Arduino.h>
 #include "analog_inputs.h"
 /* MACROS -------------------------------------------------------------------------- */
-#define NUM_PINS  3 // Currently Reading 2 Analog Pins
+#define NUM_PINS  3 // Currently Reading 3 Analog Pins
 #define LUT_SIZE 11
 
+/*
+* Worst case of filtering one channel of n conversions on the AVR: copy, insertion sort
+* with n(n-1)/2 compare-and-shift steps, sum of the middle half
+*/
+#define IR_FILTER_CYCLES(n) ((n) * ((n) - 1) / 2 * 14 + (n) * 12 + 60)
+#define IR_FILTER_FITS(n) (NUM_PINS * IR_FILTER_CYCLES(n) <= IR_FILTER_BUDGET_CYCLES)
+// Conversions kept per channel, the largest power of two the budget allows
+#define IR_OVERSAMPLE (IR_FILTER_FITS(16) ? 16 : IR_FILTER_FITS(8) ? 8 : 4)
+static_assert(IR_FILTER_FITS(IR_OVERSAMPLE), "IR_FILTER_BUDGET_CYCLES is too small for 4 conversions per channel");
+
 /* DATA TYPE DEFINITION  ----------------------------------------------------------- */
 typedef struct{
   uint8_t Pin;
@@ -18,6 +28,15 @@ analog_sense_t Sensor[] ={
   {A1,0},
   {A2,0}
 };
+
+static volatile uint16_t adc_values[NUM_PINS][IR_OVERSAMPLE];  // latest conversions of every channel
+static volatile uint8_t adc_channel;
+static volatile uint8_t adc_slot;
+
+// Analog pin to ADC multiplexer channel, A0..A7
+static uint8_t adc_mux(uint8_t pin) {
+  return (pin - A0) & 0x07;
+}
 // typedef struct{
 //   long int x;    // ADC value for the corresponding distance  (mm)
 //   long int m;    // slope between current ADC value and the next one 
@@ -71,20 +90,64 @@ analog_sense_t Sensor[] ={
 //     return -1; 
 // }
 /*
-* Gives the measured distance in mm
+* Mean of the middle half of the sorted conversions: a spike at either end is dropped as
+* with a median, the rest is averaged down. Sorts the samples in place
+*/
+static uint16_t ir_filter(uint16_t* samples) {
+  for (uint8_t i = 1; i < IR_OVERSAMPLE; i++) {
+    uint16_t value = samples[i];
+    uint8_t j = i;
+    for (; j > 0 && samples[j - 1] > value; j--)
+      samples[j] = samples[j - 1];
+    samples[j] = value;
+  }
+
+  uint16_t sum = 0;     // at most 8 10-bit conversions
+  for (uint8_t i = IR_OVERSAMPLE / 4; i < IR_OVERSAMPLE - IR_OVERSAMPLE / 4; i++)
+    sum += samples[i];
+  return sum / (IR_OVERSAMPLE / 2);
+}
+
+/*
+* Gives the filtered ADC value of every channel, over its last IR_OVERSAMPLE conversions
 */
 void distance_check(void) {
+  uint16_t samples[NUM_PINS][IR_OVERSAMPLE];
 
-  digitalWrite(8, 1);
-  Sensor[0].raw = analogRead(Sensor[0].pin);
-  delay(1);
+  // Copied while the ADC interrupt cannot update them
+  noInterrupts();
+  for (uint8_t i = 0; i < NUM_PINS; i++)
+    for (uint8_t j = 0; j < IR_OVERSAMPLE; j++)
+      samples[i][j] = adc_values[i][j];
+  interrupts();
+
+  for (uint8_t i = 0; i < NUM_PINS; i++)
+    Sensor[i].raw = ir_filter(samples[i]);
+}
 
-  Sensor[1].raw = analogRead(Sensor[1].pin);
-   delay(1);
+/*
+* Free-running conversions: the ADC complete interrupt stores the result and starts the
+* next channel, A0 -> A1 -> A2 -> A0, about 104 us each with the 125 kHz ADC clock. A
+* channel gets a new conversion every 312 us, so even the shortest IR period (20 ms)
+* sees all of its IR_OVERSAMPLE conversions replaced
+*/
+void analog_setup(void) {
+  adc_channel = 0;
+  adc_slot = 0;
+  ADMUX = (1 << REFS0) | adc_mux(Sensor[0].pin);     // AVcc reference, as analogRead(DEFAULT)
+  ADCSRA = (1 << ADEN) | (1 << ADIE) | (1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0);   // prescaler 128
+  ADCSRA |= (1 << ADSC);
+}
 
-  Sensor[2].raw = analogRead(Sensor[2].pin);
+ISR(ADC_vect) {
+  uint8_t low = ADCL;       // ADCL first, it latches ADCH
+  adc_values[adc_channel][adc_slot] = (uint16_t)(ADCH << 8) | low;
 
-  
+  adc_channel = (adc_channel + 1) % NUM_PINS;
+  if (adc_channel == 0)
+    adc_slot = (adc_slot + 1) % IR_OVERSAMPLE;
+  ADMUX = (ADMUX & 0xF0) | adc_mux(Sensor[adc_channel].pin);
+  ADCSRA |= (1 << ADSC);
 }
 
 //   analog_pin* eg = &A_Pins[pin];
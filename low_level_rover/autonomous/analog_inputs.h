@@ -6,6 +6,13 @@ typedef struct{
   long int raw;
 
 } analog_sense_t;
+/*
+* Cycles distance_check() may spend filtering the conversions of all channels, which sets
+* how many conversions per channel are kept (IR_OVERSAMPLE in analog_inputs.cpp)
+*/
+#define IR_FILTER_BUDGET_CYCLES 4000    // 250 us at 16 MHz
+
+void analog_setup(void);
 void distance_check(void);
 
 #endif
@@ -5,6 +5,8 @@
 #include "bmi323.h"
 #include "fsm_rvr.h"
 #include "PlatformOps.h"
+#include "profile_rvr.h"
+#include "motors_rvr.h"
 
 SoftServo servo;
 
@@ -13,13 +15,14 @@ SoftServo servo;
 void setup() {
   pinMode(8, OUTPUT); 
   SoftPWMBegin();  
+  motors_setup();
   servo.attach(SERVO_PIN);
   servo.write(90);
-  timer1_setup();
+  profile_setup();
   Serial.begin(115200);
 
-  Wire.begin();
-  Wire.setClock(400000);
+  twi_setup(400000);
+  analog_setup();
     // Initialize LED for status indication
   pinMode(LED_BUILTIN, OUTPUT);
   init_fsm();
@@ -33,6 +36,11 @@ void setup() {
         Serial.print("Chip ID: 0x");
         Serial.println(bmi323_get_chip_id(), HEX);
         Serial.println("I2C Address:0x68");
+
+        // Every IMU sample goes to the host through the FIFO, burst reads otherwise
+        if (!bmi323_fifo_enable(BMI323_FIFO_ODR))
+            Serial.println("BMI323 FIFO not configured, polling");
+        sensors_setup();
         
     } else {
         Serial.println("Failed to initialize BMI323 sensor!");        
@@ -28,6 +28,11 @@
 
 #include "bmi323.h"
 #include "PlatformOps.h"
+#include "twi_rvr.h"
+
+#define BMI323_TIMEOUT_MS 100
+// Dummy bytes, status, acc x/y/z, gyr x/y/z, temperature, sensor time
+#define BMI323_BURST_LEN 22
 
 //=============================================================================
 // PRIVATE VARIABLES
@@ -46,6 +51,36 @@ typedef struct {
 
 bmi323_data_t sensor_data;        ///< Internal sensor data storage
 static bmi323_config_t config;           ///< Internal configuration storage
+static uint8_t burst_buffer[BMI323_BURST_LEN];  ///< Filled by the TWI interrupt
+static bool burst_pending;               ///< Burst read started and not yet collected
+
+/**
+ * @brief FIFO reader states, one I2C transaction in flight at a time
+ */
+typedef enum {
+    FIFO_OFF,       ///< Not enabled, burst reads are used
+    FIFO_IDLE,      ///< Waiting for the next fill level poll
+    FIFO_ACC_CONF,  ///< New ODR being written to the accelerometer
+    FIFO_GYR_CONF,  ///< and to the gyroscope
+    FIFO_FLUSH,     ///< Flush command being written
+    FIFO_FILL,      ///< Fill level being read
+    FIFO_DATA,      ///< Frames being read
+    FIFO_DRAIN      ///< Frames read, handed out by bmi323_fifo_next()
+} fifo_state_t;
+
+static fifo_state_t fifo_state = FIFO_OFF;
+static bool fifo_flush_pending;
+static uint8_t fifo_odr;                 ///< ODR to write, 0 when none
+static uint8_t fifo_fill[4];             ///< Dummy bytes, fill level
+static uint8_t fifo_buffer[2 + BMI323_FIFO_MAX_FRAMES * BMI323_FIFO_FRAME_BYTES];  ///< Dummy bytes, frames
+static uint8_t fifo_frames;              ///< Frames in fifo_buffer
+static uint8_t fifo_next_frame;
+static bool fifo_complete;               ///< The burst emptied the FIFO
+static uint32_t fifo_last_poll;
+static uint32_t fifo_read_us;            ///< micros() when the burst completed
+static uint32_t fifo_time;               ///< Unwrapped sensor time of the last frame
+static uint32_t time_anchor;             ///< Sensor time matching time_anchor_us
+static uint32_t time_anchor_us;
 
 //=============================================================================
 // PRIVATE FUNCTION DECLARATIONS
@@ -71,16 +106,12 @@ static void bmi323_set_error(bmi323_error_t error);
  * @return true if write successful, false on I2C error
  */
 static bool bmi323_write_register(uint8_t reg, uint16_t data) {
-    Wire.beginTransmission(config.i2c_address);
-    Wire.write(reg);                               // Register address
-    Wire.write((uint8_t)(data & 0xFF));           // LSB first
-    Wire.write((uint8_t)((data >> 8) & 0xFF));    // MSB second
-    
-    uint8_t result = Wire.endTransmission();
-    if (result != 0) {
-        return false;
-    }
-    return true;
+    uint8_t tx[3];
+    tx[0] = reg;                               // Register address
+    tx[1] = (uint8_t)(data & 0xFF);           // LSB first
+    tx[2] = (uint8_t)((data >> 8) & 0xFF);    // MSB second
+
+    return twi_transfer(config.i2c_address, tx, 3, NULL, 0, BMI323_TIMEOUT_MS);
 }
 
 /**
@@ -97,36 +128,16 @@ static bool bmi323_write_register(uint8_t reg, uint16_t data) {
  * @return true if read successful, false on I2C error
  */
 static bool bmi323_read_register(uint8_t reg, uint16_t* data) {
-    // Send register address
-    Wire.beginTransmission(config.i2c_address);
-    Wire.write(reg);
-    
-    uint8_t result = Wire.endTransmission();
-    if (result != 0) {
-        return false;
-    }
-    
-    // Request 4 bytes according to BMI323 protocol
-    Wire.requestFrom(config.i2c_address, (uint8_t)4);
-    
-    // Wait for data with timeout
-    uint32_t timeout = millis() + 100; // 100ms timeout
-    while (Wire.available() < 4 && millis() < timeout) {
-        delay(1);
-    }
-    
-    if (Wire.available() >= 4) {
-        uint8_t buffer[4];
-        for (int i = 0; i < 4; i++) {
-            buffer[i] = Wire.read();
-        }
-        
-        // Extract data from bytes 2 and 3 (LSB, MSB)
-        *data = (uint16_t)(buffer[2] | (buffer[3] << 8));
-        return true;
-    } else {
+    uint8_t buffer[4];
+
+    // Send register address, then read 4 bytes according to BMI323 protocol
+    if (!twi_transfer(config.i2c_address, &reg, 1, buffer, 4, BMI323_TIMEOUT_MS)) {
         return false;
     }
+
+    // Extract data from bytes 2 and 3 (LSB, MSB)
+    *data = (uint16_t)(buffer[2] | (buffer[3] << 8));
+    return true;
 }
 
 /**
@@ -210,106 +221,295 @@ bool bmi323_init(void) {
 //=============================================================================
 
 
+static int16_t le_word(const uint8_t* p) {
+    return (int16_t)(p[0] | (p[1] << 8));
+}
+
+static int16_t burst_word(uint8_t index) {
+    return le_word(burst_buffer + index);
+}
+
+bool bmi323_start_burst(void) {
+    if (!config.initialized || burst_pending) {
+        return false;
+    }
+
+    uint8_t reg = BMI323_REG_STATUS;
+    burst_pending = twi_start_transfer(config.i2c_address, &reg, 1, burst_buffer, BMI323_BURST_LEN);
+    return burst_pending;
+}
+
+bool bmi323_poll_burst(void) {
+    if (!burst_pending) {
+        return false;
+    }
+
+    twi_state_t state = twi_poll();
+    if (state == TWI_BUSY) {
+        return false;
+    }
+    burst_pending = false;
+    if (state != TWI_DONE) {
+        Serial.println("err i2c rd");
+        return false;
+    }
+
+    sensor_data.status = burst_buffer[2];
+    sensor_data.acc_x = burst_word(4);
+    sensor_data.acc_y = burst_word(6);
+    sensor_data.acc_z = burst_word(8);
+    sensor_data.gyr_x = burst_word(10);
+    sensor_data.gyr_y = burst_word(12);
+    sensor_data.gyr_z = burst_word(14);
+    sensor_data.temperature = burst_word(16);
+    sensor_data.sensor_time = ((uint32_t)burst_buffer[18]);
+    sensor_data.sensor_time |= ((uint32_t) burst_buffer[19]<<8);
+    sensor_data.sensor_time |= ((uint32_t) burst_buffer[20]<<16);
+    sensor_data.sensor_time |= ((uint32_t) burst_buffer[21]<<24);
+    config.last_read_time = millis();
+
+    return true;
+}
+
 bool bmi323_read_data_burst(void){
-    const uint8_t blen = 22;
-    uint16_t temp_data;
-     //uint8_t buff[blen];
-     uint8_t buffer[4];
-     uint8_t result;
-     int i,j;
+    if (!bmi323_start_burst()) {
+        return false;
+    }
+
+    uint32_t start = millis();
+    while (twi_poll() == TWI_BUSY && millis() - start < BMI323_TIMEOUT_MS) {
+    }
+    return bmi323_poll_burst();
+}
+
+bool bmi323_fifo_enable(uint8_t odr) {
+    uint16_t time_lo;
+    uint16_t time_hi;
+
     if (!config.initialized) {
         return false;
     }
-        
-    Wire.beginTransmission(config.i2c_address);
-    Wire.write(BMI323_REG_STATUS);
-    
-    result = Wire.endTransmission();
-    if (result != 0) {
+
+    // Same mode and range as bmi323_init(), at the streaming rate
+    if (!bmi323_write_register(BMI323_REG_ACC_CONF, (0x4618 & ~BMI323_CONF_ODR_MASK) | odr) ||
+        !bmi323_write_register(BMI323_REG_GYR_CONF, (0x4638 & ~BMI323_CONF_ODR_MASK) | odr)) {
         return false;
     }
-    
-    // Request 4 bytes according to BMI323 protocol
-    Wire.requestFrom(config.i2c_address, (uint8_t)blen);
-    
-    // Wait for data with timeout
-    uint32_t timeout = millis() + 100; // 100ms timeout
-    while (Wire.available() < blen && millis() < timeout) {
-        delay(1);
+    if (!bmi323_write_register(BMI323_REG_FIFO_WATERMARK, BMI323_FIFO_WATERMARK_FRAMES * BMI323_FIFO_FRAME_WORDS) ||
+        !bmi323_write_register(BMI323_REG_FIFO_CONF, BMI323_FIFO_CONF_STREAM) ||
+        !bmi323_write_register(BMI323_REG_FIFO_CTRL, BMI323_FIFO_CTRL_FLUSH)) {
+        return false;
     }
-    
-     if (Wire.available() >= blen) {
-       
-        for ( i = 0, j= 0; i < 4; i++, j++) {
-            buffer[i] = Wire.read();
+
+    // Frames only carry the low word of the sensor time, the high word is tracked from here
+    if (!bmi323_read_register(BMI323_REG_SENSOR_TIME_0, &time_lo) ||
+        !bmi323_read_register(BMI323_REG_SENSOR_TIME_1, &time_hi)) {
+        return false;
+    }
+    fifo_time = ((uint32_t)time_hi << 16) | time_lo;
+    time_anchor = fifo_time;
+    time_anchor_us = micros();
+
+    fifo_flush_pending = false;
+    fifo_odr = 0;
+    fifo_last_poll = millis();
+    fifo_state = FIFO_IDLE;
+    return true;
+}
+
+bool bmi323_fifo_enabled(void) {
+    return fifo_state != FIFO_OFF;
+}
+
+void bmi323_fifo_flush(void) {
+    if (fifo_state != FIFO_OFF) {
+        fifo_flush_pending = true;
+    }
+}
+
+void bmi323_fifo_set_odr(uint8_t odr) {
+    if (fifo_state != FIFO_OFF) {
+        fifo_odr = odr;
+    }
+}
+
+uint8_t bmi323_odr_for_period(uint16_t period_ms) {
+    // ODR periods in 0.1 ms, 12.5 Hz to 400 Hz
+    static const uint16_t periods[] = {800, 400, 200, 100, 50, 25};
+    static const uint8_t odrs[] = {BMI323_ODR_12_5HZ, BMI323_ODR_25HZ, BMI323_ODR_50HZ,
+                                   BMI323_ODR_100HZ, BMI323_ODR_200HZ, BMI323_ODR_400HZ};
+    uint32_t period = (uint32_t)period_ms * 10;
+
+    for (uint8_t i = 0; i < sizeof(odrs); i++) {
+        if (periods[i] <= period) {
+            return odrs[i];
         }
-        sensor_data.status = buffer[2];//|buffer[3]<<8;
+    }
+    return BMI323_ODR_400HZ;
+}
+
+static bool fifo_start_write(uint8_t reg, uint16_t data) {
+    uint8_t tx[3];
+    tx[0] = reg;
+    tx[1] = (uint8_t)(data & 0xFF);
+    tx[2] = (uint8_t)(data >> 8);
+    return twi_start_transfer(config.i2c_address, tx, 3, NULL, 0);
+}
 
+void bmi323_fifo_update(void) {
+    twi_state_t state;
+    uint8_t tx[1];
 
-        for ( i = 0; i < 2; i++,j++) {
-            buffer[i] = Wire.read();
+    switch (fifo_state) {
+    case FIFO_OFF:
+        break;
+
+    case FIFO_IDLE:
+        if (fifo_odr != 0) {
+            if (fifo_start_write(BMI323_REG_ACC_CONF, (0x4618 & ~BMI323_CONF_ODR_MASK) | fifo_odr)) {
+                fifo_state = FIFO_ACC_CONF;
+            }
+            break;
+        }
+        if (fifo_flush_pending) {
+            if (fifo_start_write(BMI323_REG_FIFO_CTRL, BMI323_FIFO_CTRL_FLUSH)) {
+                fifo_flush_pending = false;
+                fifo_state = FIFO_FLUSH;
+            }
+            break;
+        }
+        if (millis() - fifo_last_poll >= BMI323_FIFO_POLL_MS) {
+            tx[0] = BMI323_REG_FIFO_FILL_LEVEL;
+            if (twi_start_transfer(config.i2c_address, tx, 1, fifo_fill, sizeof(fifo_fill))) {
+                fifo_last_poll = millis();
+                fifo_state = FIFO_FILL;
+            }
         }
-        sensor_data.acc_x = ((uint16_t)(buffer[0] | buffer[1]<<8));
+        break;
 
-        for ( i = 0; i < 2; i++,j++) {
-            buffer[i] = Wire.read();
+    case FIFO_ACC_CONF:
+        if (twi_poll() != TWI_BUSY && fifo_start_write(BMI323_REG_GYR_CONF, (0x4638 & ~BMI323_CONF_ODR_MASK) | fifo_odr)) {
+            fifo_state = FIFO_GYR_CONF;
         }
-        sensor_data.acc_y = ((uint16_t)(buffer[0] | buffer[1]<<8));
+        break;
+
+    case FIFO_GYR_CONF:
+        if (twi_poll() != TWI_BUSY) {
+            // Frames at the old rate would be stamped and spaced wrongly from here
+            fifo_odr = 0;
+            fifo_flush_pending = true;
+            fifo_state = FIFO_IDLE;
+        }
+        break;
 
-        for ( i = 0; i < 2; i++,j++) {
-            buffer[i] = Wire.read();
+    case FIFO_FLUSH:
+        if (twi_poll() != TWI_BUSY) {
+            fifo_state = FIFO_IDLE;
         }
-        sensor_data.acc_z = ((uint16_t)(buffer[0] | buffer[1]<<8));
-//10
+        break;
 
-        for ( i = 0; i < 2; i++,j++) {
-            buffer[i] = Wire.read();
+    case FIFO_FILL: {
+        state = twi_poll();
+        if (state == TWI_BUSY) {
+            break;
+        }
+        fifo_state = FIFO_IDLE;
+        if (state != TWI_DONE) {
+            Serial.println("err i2c rd");
+            break;
         }
-        sensor_data.gyr_x = ((uint16_t)(buffer[0] | buffer[1]<<8));
 
-        for ( i = 0; i < 2; i++,j++) {
-            buffer[i] = Wire.read();
+        uint16_t words = (uint16_t)(fifo_fill[2] | (fifo_fill[3] << 8)) & 0x07FF;
+        if (words >= BMI323_FIFO_CAPACITY_WORDS) {
+            // Oldest samples were overwritten, the host was not keeping up
+            Serial.println("<err,1,fifo>");
+        }
+        uint16_t available = words / BMI323_FIFO_FRAME_WORDS;
+        if (available < BMI323_FIFO_WATERMARK_FRAMES) {
+            break;
         }
-        sensor_data.gyr_y = ((uint16_t)(buffer[0] | buffer[1]<<8)); 
+        fifo_frames = available < BMI323_FIFO_MAX_FRAMES ? (uint8_t)available : BMI323_FIFO_MAX_FRAMES;
+        fifo_complete = fifo_frames == available;
+        tx[0] = BMI323_REG_FIFO_DATA;
+        if (twi_start_transfer(config.i2c_address, tx, 1, fifo_buffer, 2 + fifo_frames * BMI323_FIFO_FRAME_BYTES)) {
+            fifo_state = FIFO_DATA;
+        }
+        break;
+    }
 
-        for ( i = 0; i < 2; i++,j++) {
-            buffer[i] = Wire.read();
+    case FIFO_DATA:
+        state = twi_poll();
+        if (state == TWI_BUSY) {
+            break;
+        }
+        if (state != TWI_DONE) {
+            Serial.println("err i2c rd");
+            fifo_state = FIFO_IDLE;
+            break;
         }
-        sensor_data.gyr_z = ((uint16_t)(buffer[0] | buffer[1]<<8));
+        fifo_read_us = micros();
+        fifo_next_frame = 0;
+        fifo_state = FIFO_DRAIN;
+        break;
+
+    case FIFO_DRAIN:
+        // The next burst waits for bmi323_fifo_next() to hand out this one
+        break;
+    }
+}
+
+bool bmi323_fifo_next(void) {
+    if (fifo_state != FIFO_DRAIN) {
+        return false;
+    }
 
-        for ( i = 0; i < 2; i++,j++) {
-            buffer[i] = Wire.read();
+    while (fifo_next_frame < fifo_frames) {
+        const uint8_t* frame = fifo_buffer + 2 + fifo_next_frame * BMI323_FIFO_FRAME_BYTES;
+        fifo_next_frame++;
+        bool last = fifo_next_frame == fifo_frames;
+        if (last) {
+            fifo_state = FIFO_IDLE;
         }
-        sensor_data.temperature = ((uint16_t)(buffer[0] | buffer[1]<<8));
-        
-        for ( i = 0; i < 4; i++,j++) {
-            buffer[i] = Wire.read();
+        if ((uint16_t)le_word(frame) == BMI323_FIFO_DUMMY_ACC) {
+            continue;
         }
-        // Serial.print( "J is:");
-        // Serial.print(j);
-        // Serial.println();
-        // Serial.print(buffer[0],HEX);
-        // Serial.print(" ");
-        // Serial.print(buffer[1],HEX);
-        // Serial.print(" ");
-        // Serial.print(buffer[2],HEX);
-        // Serial.print(" ");
-        // Serial.println(buffer[3],HEX);
-        sensor_data.sensor_time = ((uint32_t)buffer[0]);
-        sensor_data.sensor_time |= ((uint32_t) buffer[1]<<8);
-        sensor_data.sensor_time |= ((uint32_t) buffer[2]<<16);
-        sensor_data.sensor_time |= ((uint32_t) buffer[3]<<24);
-      
 
+        sensor_data.acc_x = le_word(frame);
+        sensor_data.acc_y = le_word(frame + 2);
+        sensor_data.acc_z = le_word(frame + 4);
+        sensor_data.gyr_x = le_word(frame + 6);
+        sensor_data.gyr_y = le_word(frame + 8);
+        sensor_data.gyr_z = le_word(frame + 10);
+        sensor_data.temperature = le_word(frame + 12);
+
+        uint16_t time_lo = (uint16_t)le_word(frame + 14);
+        if (time_lo < (uint16_t)fifo_time) {
+            fifo_time += 0x10000UL;    // low word wrapped, every 2.56 s
+        }
+        fifo_time = (fifo_time & 0xFFFF0000UL) | time_lo;
+        sensor_data.sensor_time = fifo_time;
 
+        if (last && fifo_complete) {
+            // The newest frame of an emptied FIFO is at most one ODR period old
+            time_anchor = fifo_time;
+            time_anchor_us = fifo_read_us;
+        }
         return true;
-        }else{
-        Serial.println("err i2c rd");
-      
     }
+
+    fifo_state = FIFO_IDLE;
     return false;
 }
 
+uint32_t bmi323_sensor_time_now(void) {
+    if (fifo_state == FIFO_OFF) {
+        return sensor_data.sensor_time;
+    }
+    // Sensor time ticks are 39.0625 us, 16 ticks every 625 us
+    uint32_t elapsed_us = micros() - time_anchor_us;
+    return time_anchor + (elapsed_us / 625) * 16 + (elapsed_us % 625) * 16 / 625;
+}
+
 bool bmi323_read_data(void) {
     if (!config.initialized) {
         return false;
@@ -76,10 +76,17 @@ extern "C" {
 #define BMI323_REG_GYR_DATA_Y     0x07  ///< Gyroscope Y-axis data register
 #define BMI323_REG_GYR_DATA_Z     0x08  ///< Gyroscope Z-axis data register
 #define BMI323_REG_TEMP_DATA      0x09
+#define BMI323_REG_SENSOR_TIME_0  0x0A  ///< Sensor time, low word
+#define BMI323_REG_SENSOR_TIME_1  0x0B  ///< Sensor time, high word
+#define BMI323_REG_FIFO_FILL_LEVEL 0x15 ///< FIFO fill level in words
+#define BMI323_REG_FIFO_DATA      0x16  ///< FIFO read port
 
 
 #define BMI323_REG_ACC_CONF       0x20  ///< Accelerometer configuration register
 #define BMI323_REG_GYR_CONF       0x21  ///< Gyroscope configuration register
+#define BMI323_REG_FIFO_WATERMARK 0x35  ///< FIFO watermark in words
+#define BMI323_REG_FIFO_CONF      0x36  ///< FIFO frame content
+#define BMI323_REG_FIFO_CTRL      0x37  ///< FIFO flush
 
 
 #define BMI323_REG_CMD            0x7E  ///< Command register
@@ -88,6 +95,30 @@ extern "C" {
 #define BMI323_CHIP_ID_VALUE      0x43    ///< Expected chip ID value
 #define BMI323_CMD_SOFT_RESET     0xDEAF  ///< Soft reset command value
 
+// Output data rates, ODR field of ACC_CONF and GYR_CONF
+#define BMI323_CONF_ODR_MASK      0x000F
+#define BMI323_ODR_12_5HZ         0x05
+#define BMI323_ODR_25HZ           0x06
+#define BMI323_ODR_50HZ           0x07
+#define BMI323_ODR_100HZ          0x08
+#define BMI323_ODR_200HZ          0x09
+#define BMI323_ODR_400HZ          0x0A
+
+// FIFO, frames of acc x/y/z, gyr x/y/z, temperature and the low word of the sensor time
+#define BMI323_FIFO_CONF_STREAM   0x0F00  ///< fifo_time_en | fifo_acc_en | fifo_gyr_en | fifo_temp_en, oldest data overwritten when full
+#define BMI323_FIFO_CTRL_FLUSH    0x0001
+#define BMI323_FIFO_CAPACITY_WORDS 1024
+#define BMI323_FIFO_FRAME_WORDS   8
+#define BMI323_FIFO_FRAME_BYTES   (2 * BMI323_FIFO_FRAME_WORDS)
+#define BMI323_FIFO_DUMMY_ACC     0x7F01  ///< acc x of a frame read past the end of the FIFO
+#define BMI323_FIFO_WATERMARK_FRAMES 4    ///< frames collected before a burst read
+#define BMI323_FIFO_MAX_FRAMES    8       ///< frames per burst read
+#define BMI323_FIFO_POLL_MS       5       ///< fill level poll period
+
+#ifndef BMI323_FIFO_ODR
+#define BMI323_FIFO_ODR           BMI323_ODR_200HZ
+#endif
+
 // Conversion Factors
 #define BMI323_ACCEL_SCALE_4G     8.19f   ///< Accelerometer scale factor for ±4g range
 #define BMI323_GYRO_SCALE_1000DPS 32.768f ///< Gyroscope scale factor for ±1000dps range
@@ -135,10 +166,10 @@ typedef struct {
  * 
  * @return true if initialization successful, false on any error
  * 
- * @note Must call Wire.begin() before calling this function
+ * @note Must call twi_setup() before calling this function
  * 
  * @example
- * Wire.begin();
+ * twi_setup(400000);
  * if (bmi323_init()) {
  *     Serial.println("Sensor ready!");
  * } else {
@@ -189,8 +220,99 @@ bool bmi323_check_connection(void);
 bool bmi323_read_data(void);
 
 
+/**
+ * @brief Burst read of status, accelerometer, gyroscope, temperature and sensor time
+ *
+ * Blocking form of bmi323_start_burst() followed by bmi323_poll_burst().
+ *
+ * @return true if the data was read
+ */
 bool bmi323_read_data_burst(void);
 
+/**
+ * @brief Start a burst read in the background
+ *
+ * The TWI interrupt fills an internal buffer; bmi323_poll_burst() decodes it.
+ *
+ * @return true if started, false while the previous burst is not collected yet
+ */
+bool bmi323_start_burst(void);
+
+/**
+ * @brief Collect a finished burst read
+ *
+ * @return true once per completed burst, after the sensor data was updated
+ *
+ * @note Never waits; returns false while the transfer is still running
+ */
+bool bmi323_poll_burst(void);
+
+/**
+ * @brief Stream accelerometer and gyroscope samples through the FIFO
+ *
+ * Sets both sensors to the given ODR, enables acc, gyr, temperature and sensor time frames and flushes
+ * the FIFO. From then on bmi323_fifo_update() collects the frames in bursts once the
+ * watermark is reached and bmi323_fifo_next() hands them out one by one, so every
+ * sample reaches the host whatever the loop rate. The fill level is polled over I2C,
+ * no interrupt line is needed.
+ *
+ * @param odr BMI323_ODR_* value
+ * @return true if configured, false on I2C error (burst reads keep working)
+ *
+ * @note Blocking, call once after bmi323_init()
+ */
+bool bmi323_fifo_enable(uint8_t odr);
+
+/**
+ * @brief true once bmi323_fifo_enable() succeeded
+ */
+bool bmi323_fifo_enabled(void);
+
+/**
+ * @brief Drop the queued samples, e.g. when sampling (re)starts
+ *
+ * @note Done by bmi323_fifo_update() once the current transfer is over
+ */
+void bmi323_fifo_flush(void);
+
+/**
+ * @brief Change the streaming ODR, e.g. for a new IMU sampling period
+ *
+ * @note Written by bmi323_fifo_update() once the current transfer is over, then the FIFO
+ *       is flushed
+ */
+void bmi323_fifo_set_odr(uint8_t odr);
+
+/**
+ * @brief Slowest ODR sampling at least once per period
+ */
+uint8_t bmi323_odr_for_period(uint16_t period_ms);
+
+/**
+ * @brief Advance the FIFO reads, never waits
+ *
+ * Polls the fill level every BMI323_FIFO_POLL_MS and starts a burst read of up to
+ * BMI323_FIFO_MAX_FRAMES frames once BMI323_FIFO_WATERMARK_FRAMES are queued.
+ */
+void bmi323_fifo_update(void);
+
+/**
+ * @brief Move the next FIFO sample into the sensor data
+ *
+ * Updates acc, gyr, temperature and sensor_time (unwrapped to 32 bits). The next burst is only read
+ * once the current one is consumed.
+ *
+ * @return false when no sample is waiting
+ */
+bool bmi323_fifo_next(void);
+
+/**
+ * @brief Current sensor time, extrapolated from the last FIFO burst with micros()
+ *
+ * Lets the samples sent outside the FIFO share its time base, to within one ODR period.
+ */
+uint32_t bmi323_sensor_time_now(void);
+
 /**
  * @brief Print formatted sensor data to Serial
  * 
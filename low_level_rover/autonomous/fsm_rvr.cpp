@@ -1,11 +1,14 @@
 #include "fsm_rvr.h"
 #include "parser.h"
 #include "PlatformOps.h"
+#include "profile_rvr.h"
+#include "sched_rvr.h"
 
 bool StatusRunning;
 FSMState currentState;
 Frame currentFrame;
-String serialIn;
+char serialIn[FRAME_BUFFER_SIZE];
+uint8_t serialInLength = 0;
 
 
 
@@ -26,25 +29,21 @@ void encode_fsm() {
 
     case READ_FRAME:
         //Serial.println("STATE: READ_FRAME");
-        if(handleSerialInput(serialIn)){ 
-            //Serial.println(serialIn);
-            if (parseFrame(serialIn, currentFrame)) {
+        // Every complete frame waiting in the UART buffer is handled in this pass
+        currentState = StatusRunning ? RUNNING : READY;
+        while(handleSerialInput(serialIn, serialInLength)){ 
+            //Serial.write(serialIn, serialInLength);
+            if (parseFrame(serialIn, serialInLength, currentFrame)) {
                 //Serial.println("Frame parsed OK");
                 currentState = (FSMState)executeCommand(currentFrame);
-               
+                if (currentState == READY)
+                    StatusRunning = false;  // as the READY state would, before the next frame
             }
             else {
+                // A corrupt frame does not stop a running system
                 Serial.println("<err,1,frm>");
-                currentState = READY;
             }
-             serialIn = "";
-        }
-        else {
-            if (StatusRunning) {
-                currentState = RUNNING;
-            }
-            else
-                currentState = READY;
+             serialInLength = 0;
         }
         
         
@@ -54,7 +53,13 @@ void encode_fsm() {
         
        //Serial.println("STATE: RUNNING");
 
+       if (ProfileTick) {
+           ProfileTick = false;
+           profile_update();
+       }
+
        check_receiving_speed_frames();
+       sensors_update();
 
         if (Serial.available()) {
             //Serial.println("New frame detected during RUNNING");
@@ -62,9 +67,8 @@ void encode_fsm() {
             break;
         }
 
-        if (SampleSensors) {
-            SampleSensors  = false;
-            //Serial.println("Timeout occurred! Switching to READ_SENSORS");
+        if (sched_pending()) {
+            //Serial.println("Channel due! Switching to READ_SENSORS");
             currentState = READ_SENSORS;
         }
         else {
@@ -74,7 +78,7 @@ void encode_fsm() {
 
     case READ_SENSORS:
         //Serial.println("STATE: READ_SENSORS");
-        readSensors();
+        sched_run();
 
         currentState =RUNNING;
         break;
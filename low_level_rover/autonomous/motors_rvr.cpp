@@ -4,7 +4,6 @@
 #include "PlatformOps.h"
 
 #define NUM_PWMS 13
-#define MOTORS_PAYLOAD_NUM 2
 #define PWM_MIN 0
 #define PWM_MAX 255
 
@@ -12,6 +11,10 @@ typedef struct{
   float pwm;
   int8_t forward_pin;
   int8_t backward_pin;
+#if MOTORS_HW_PWM
+  volatile uint16_t* ocr;     // timer 3 compare register driving forward_pin
+  uint8_t com_bit;            // its output enable in TCCR3A
+#endif
 }SunFounder_cfg;
 
 typedef struct{
@@ -21,18 +24,88 @@ typedef struct{
 static bool MotorRunning;
 payload_motors payload;
 
+#if MOTORS_HW_PWM
+// Pins 2 and 5 are OC3B and OC3A on the Mega; 3 and 4 are plain direction outputs
+SunFounder_cfg left_Motor = {.pwm = 0.0,
+                            .forward_pin = 2,
+                            .backward_pin = 3,
+                            .ocr = &OCR3B,
+                            .com_bit = COM3B1};
+SunFounder_cfg right_Motor = {.pwm = 0.0,
+                             .forward_pin = 5,
+                             .backward_pin = 4,
+                             .ocr = &OCR3A,
+                             .com_bit = COM3A1};
+#else
 SunFounder_cfg left_Motor = {.pwm = 0.0,
                             .forward_pin = 2,
                             .backward_pin = 3};
 SunFounder_cfg right_Motor = {.pwm = 0.0,
                              .forward_pin = 5,
                              .backward_pin = 4};
+#endif
 
 /*
 * <<<<<<<<<<<<<<<<<<<<<<<<< IMPORTANT INFORMATION >>>>>>>>>>>>>>>>>>>>>>>>>>
 * Values received for duty-cycle can be floats and must be between 0 and 255
 */
 
+#if MOTORS_HW_PWM
+/*
+* Timer 3 in fast PWM with ICR3 as TOP, no prescaler: MOTORS_PWM_HZ on OC3A/OC3B
+* with no interrupt at all, instead of the 60 Hz of the SoftPWM ISR
+*/
+void motors_setup(void){
+  pinMode(left_Motor.forward_pin, OUTPUT);
+  pinMode(left_Motor.backward_pin, OUTPUT);
+  pinMode(right_Motor.forward_pin, OUTPUT);
+  pinMode(right_Motor.backward_pin, OUTPUT);
+  digitalWrite(left_Motor.forward_pin, LOW);
+  digitalWrite(left_Motor.backward_pin, LOW);
+  digitalWrite(right_Motor.forward_pin, LOW);
+  digitalWrite(right_Motor.backward_pin, LOW);
+
+  TCCR3A = (1 << WGM31);
+  TCCR3B = (1 << WGM33) | (1 << WGM32) | (1 << CS30);
+  ICR3 = MOTORS_PWM_TOP;
+  OCR3A = 0;
+  OCR3B = 0;
+}
+
+/*
+* Sign-magnitude drive of the bridge: the backward input is the direction and the forward
+* input gets the PWM, inverted when reversing so the motor sees the same duty
+*/
+static void motor_drive(const SunFounder_cfg* motor){
+  uint16_t duty = (uint16_t)abs(motor->pwm);
+  bool backward = motor->pwm < 0;
+  uint16_t on = backward ? PWM_MAX - duty : duty;
+
+  digitalWrite(motor->backward_pin, backward ? HIGH : LOW);
+  if (on == 0) {
+    // Fast PWM still gives a one-cycle pulse at 0, hold the pin low instead
+    TCCR3A &= ~(1 << motor->com_bit);
+    digitalWrite(motor->forward_pin, LOW);
+  } else {
+    *motor->ocr = (uint16_t)((uint32_t)on * MOTORS_PWM_TOP / PWM_MAX);
+    TCCR3A |= (1 << motor->com_bit);
+  }
+}
+
+/*
+* Updates motor Variables and updates movement
+*/
+void car_update(void){
+  left_Motor.pwm = payload.speedLeft;
+  right_Motor.pwm = payload.speedRight;
+
+  motor_drive(&left_Motor);
+  motor_drive(&right_Motor);
+}
+#else
+void motors_setup(void){
+}
+
 /*
 * Updates motor Variables and updates movement
 */
@@ -62,30 +135,24 @@ void car_update(void){
   }
   
 }
+#endif
 
-int parser_motors(String *data){
-  if(data[MOTORS_PAYLOAD_NUM+1] == ""){ // Check the payload length
-    payload.speedLeft = data[1].toFloat();
-    payload.speedRight = data[2].toFloat();
-    // Check if received data is between the limits accepted
-    if((payload.speedLeft < PWM_MIN) || (payload.speedLeft > PWM_MAX ) ||
-      (payload.speedRight < PWM_MIN) || (payload.speedRight > PWM_MAX))
-        return -1;
-      
-    car_update();
-    return 0;
-  }else
-    return -1;    // more payloads than required
+int parser_motors(const Frame * p_frm){
+    return motors_set_duty(p_frm->val1, p_frm->val2);
 }
 
-int parser_motors(const Frame * p_frm){
+/*
+* Signed duty-cycles, -255..255, negative turns the wheel backwards
+*/
+int motors_set_duty(int left, int right){
 
-    if(abs(p_frm->val1) > PWM_MAX || abs(p_frm->val2) > PWM_MAX )
+    if(abs(left) > PWM_MAX || abs(right) > PWM_MAX )
         return -1;
-    payload.speedLeft = (float)p_frm->val1;//.toFloat();
-    payload.speedRight = (float) p_frm->val2;//.toFloat();
+    payload.speedLeft = (float)left;
+    payload.speedRight = (float)right;
 
-    if (p_frm->val1 > 0 || p_frm->val2 > 0) {
+    // Reversing wheels are in motion too, the watchdog must cover them
+    if (left != 0 || right != 0) {
         MotorRunning = true;
     }
     else
@@ -96,6 +163,12 @@ int parser_motors(const Frame * p_frm){
 
 }
 
+void motors_get_duty(int* left, int* right)
+{
+    *left = (int)payload.speedLeft;
+    *right = (int)payload.speedRight;
+}
+
 bool motors_in_motion(void)
 {
     return MotorRunning;
@@ -5,6 +5,22 @@
 #include <stdint.h>
 
 #include "parser.h"
+
+/*
+ * On the Mega the wheels are driven by timer 3 hardware PWM with a direction pin each;
+ * other boards fall back to SoftPWM on both bridge inputs. SoftPWM is left to the servo.
+ */
+#ifndef MOTORS_HW_PWM
+#if defined(__AVR_ATmega2560__)
+#define MOTORS_HW_PWM 1
+#else
+#define MOTORS_HW_PWM 0
+#endif
+#endif
+
+#define MOTORS_PWM_HZ 20000         // above hearing
+#define MOTORS_PWM_TOP (F_CPU / MOTORS_PWM_HZ - 1)
+
 /*
  *  [0]--|||--[1]
  *   |         |
@@ -15,8 +31,10 @@
  *  [0]-------[1]
  */
 
-int parser_motors(String* );
+void motors_setup(void);
 int parser_motors(const Frame * p_frm);
+int motors_set_duty(int left, int right);
+void motors_get_duty(int* left, int* right);
 bool motors_in_motion(void);
 #endif // __CAR_CONTROL_H__
 
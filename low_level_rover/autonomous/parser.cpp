@@ -5,116 +5,19 @@
 #include <math.h>
 #include "fsm_rvr.h"
 #include "PlatformOps.h"
+#include "profile_rvr.h"
 
 /*
-* INPUT: YY xxx xxx\r\n
+* INPUT: <cmd,N,v1,...,vN>\r\n
 */
 
-#define COMMAND_INDEX 0 // command index on the received data
-#define COMMANDS 2  // number of commands
-
-typedef enum {MOTORS = 0, SERVO} commands_receive;
-String headers [] = {"ws", "ss"};   // YY
-
-String data [MAX_PAYLOAD_NUM+2];
-
-void clear_data (void);
-
 extern bool StatusRunning;
 
-typedef int (*func_ptr)(String*);
-
-func_ptr parser_funcs [COMMANDS] = {
-   parser_motors,
-   parser_servo
-};
-
-
-
-
-/*
-* Scans the message received and splits them in token
-* to verify if the package is corret and to extract the speeds
-* from left and right motors
-*/
-int scanner(String str) {
-  str.trim();  
-
-  int start = 0;
-  int index = str.indexOf(' ');
-  int i = 0;
-
-
-  while ((i < MAX_PAYLOAD_NUM) && (index != -1)) {
-    String parte = str.substring(start, index);
-    if (parte.length() > 0) {
-      data[i] = parte;
-      i++;
-    }
-    start = index + 1;
-    index = str.indexOf(' ', start);
-  }
-
-  // Last item (or only)
-  if ((i < MAX_PAYLOAD_NUM) && (start < str.length())) {
-    String lastItem = str.substring(start);
-    if (lastItem.length() > 0) {
-      data[i] = lastItem;
-      i++;
-    }
-  }
-
-  // Check if first element is a command
-  for (int a = 0; a < COMMANDS; a++) {
-    if (data[0] == headers[a]) {
-       Serial.print("0: "); Serial.println(data[0]);
-       Serial.print("1: "); Serial.println(data[1]);
-       Serial.print("2: "); Serial.println(data[2]);
-      return 0;
-    }
-  }
-   
-  // Comando inválido
-  clear_data();
-  Serial.println("err inv cmd");
-  return -1;
-}
-
-
-
-// int parser (void){
-//   int a;
-//   for (a = 0; a < COMMANDS; a++){
-//     if(data[0] == headers[a])
-//       break;
-//   }
-//   switch (a){
-//     case MOTORS:
-//       parser_funcs[MOTORS](data);
-//       clear_data();
-//       return 0;
-//     case SERVO:
-//       parser_funcs[SERVO](data);
-//       clear_data();
-//       return 0;
-//     default:
-//       clear_data();
-//       return -1;
-//   }
-// }
-
-// Clear data string array
-void clear_data (void){
-  for (int a = 0; ((a < MAX_PAYLOAD_NUM+2-1) && data[a] != ""); a++)
-    data[a]= "";
-}
-
 void print_frame(Frame* p_frm)
 {
     Serial.println("Frame Parsed Successfully!");
 
     Serial.println("Frame Parsed:");
-    Serial.print("CMD: "); Serial.println(p_frm->cmd);
     printCommandType(p_frm->type);
     Serial.print("LEN: "); Serial.println(p_frm->length);
     if (p_frm->length > 0) {
@@ -130,40 +33,88 @@ void print_frame(Frame* p_frm)
 
 
 
-String removeCRLF(const String& s) {
-    String str = s;
-    while (str.length() > 0 && (str.charAt(str.length() - 1) == '\n' || str.charAt(str.length() - 1) == '\r'))
-        str.remove(str.length() - 1);
-    return str;
-}
+typedef struct {
+    const char* name;
+    CommandType type;
+} CommandName;
 
-String getToken(String& input, char delimiter) {
-    int index = input.indexOf(delimiter);
-    if (index == -1) { String token = input; input = ""; return token; }
-    String token = input.substring(0, index);
-    input = input.substring(index + 1);
-    return token;
-}
+static const CommandName commands[] = {
+    {"start", CMD_START},
+    {"stop",  CMD_STOP},
+    {"ws",    CMD_WS},
+    {"ss",    CMD_SS},
+    {"wp",    CMD_WP},
+    {"wr",    CMD_WR},
+    {"sr",    CMD_SR}
+};
 
-CommandType commandFromString(const String& cmd) {
-    if (cmd.equalsIgnoreCase("start")) return CMD_START;
-    if (cmd.equalsIgnoreCase("stop"))  return CMD_STOP;
-    if (cmd.equalsIgnoreCase("ws"))    return CMD_WS;
-    if (cmd.equalsIgnoreCase("ss"))    return CMD_SS;
+CommandType commandFromString(const char* cmd, uint8_t len) {
+    for (uint8_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        if (strlen(commands[i].name) == len && strncasecmp(cmd, commands[i].name, len) == 0)
+            return commands[i].type;
+    }
     return CMD_UNKNOWN;
 }
 
-bool parseFrame(const String& rawInput, Frame& frame) {
-    String inputFrame = removeCRLF(rawInput);
-    if (inputFrame.length() < 4 || inputFrame.charAt(0) != '<' || inputFrame.charAt(inputFrame.length() - 1) != '>')
+/*
+* Single pass over <cmd,N,v1,...>, trailing CR/LF ignored. The payload must hold exactly
+* N values, the unused slots read as -1; anything but an optional sign and digits in a
+* value is an error
+*/
+bool parseFrame(const char* input, uint8_t len, Frame& frame) {
+    while (len > 0 && (input[len - 1] == '\n' || input[len - 1] == '\r'))
+        len--;
+    if (len < 4 || input[0] != '<' || input[len - 1] != '>')
+        return false;
+
+    uint8_t pos = 1;
+    uint8_t end = len - 1;
+    uint8_t name_start = pos;
+    while (pos < end && input[pos] != ',')
+        pos++;
+    frame.type = commandFromString(input + name_start, pos - name_start);
+
+    // Token 0 is the payload length, then the values
+    int8_t token = -1;
+    for (uint8_t i = 0; i < FRAME_MAX_VALUES; i++)
+        frame.values[i] = -1;
+    frame.length = 0;
+    while (pos < end) {
+        pos++;      // skip the ','
+        bool negative = false;
+        bool digits = false;
+        long value = 0;
+        if (pos < end && (input[pos] == '-' || input[pos] == '+')) {
+            negative = input[pos] == '-';
+            pos++;
+        }
+        while (pos < end && input[pos] >= '0' && input[pos] <= '9') {
+            value = value * 10 + (input[pos] - '0');
+            if (value > 32767)
+                return false;
+            digits = true;
+            pos++;
+        }
+        if (!digits || (pos < end && input[pos] != ','))
+            return false;
+        if (negative)
+            value = -value;
+
+        if (token < 0) {
+            frame.length = (int)value;
+        } else if (token < FRAME_MAX_VALUES) {
+            frame.values[token] = (int)value;
+        } else {
+            return false;
+        }
+        token++;
+    }
+    // A short payload would run with -1 in place of the missing values
+    if (token < 0 || token != frame.length)
         return false;
 
-    String content = inputFrame.substring(1, inputFrame.length() - 1);
-    frame.cmd = getToken(content, ',');
-    frame.type = commandFromString(frame.cmd);
-    frame.length = getToken(content, ',').toInt();
-    frame.val1 = (content.length() > 0) ? getToken(content, ',').toInt() : -1;
-    frame.val2 = (content.length() > 0) ? content.toInt() : -1;
+    frame.val1 = frame.values[0];
+    frame.val2 = frame.values[1];
     return true;
 }
 
@@ -174,7 +125,7 @@ int executeCommand(const Frame& f) {
     switch (f.type) {
     case CMD_START: 
         ret = (int)RUNNING;
-        timer1_stop();
+        sampling_stop();
         // Serial.println("CMD START");
         // Serial.println(f.length);
         // Serial.println(f.val1);
@@ -183,12 +134,12 @@ int executeCommand(const Frame& f) {
           if(f.val1>=20 && f.val1 <=1000){
 
 
-            timer1_start(f.val1);
+            sampling_start(f.val1);
             //Serial.println(ms);
           }
         }
         else {
-            timer1_start();
+            sampling_start();
         }
         //Serial.println("Action: System STARTED"); 
        
@@ -197,8 +148,8 @@ int executeCommand(const Frame& f) {
     case CMD_STOP:  
         //Serial.println("Action: System STOPPED"); 
         ret = (int)READY;
-        timer1_stop();
-        temp.cmd = CMD_WS;
+        sampling_stop();
+        temp.type = CMD_WS;
         temp.val1=0;
         temp.val2=0;
         parser_motors(&temp);
@@ -211,6 +162,7 @@ int executeCommand(const Frame& f) {
         //Serial.print(" val2="); 
         //Serial.println(f.val2);
         if(StatusRunning){
+          profile_cancel();
           parser_motors(&f);
           ack_receiving_speed_frames();
           ret = RUNNING;
@@ -228,8 +180,28 @@ int executeCommand(const Frame& f) {
         }else
         ret=READY;
         break;
+    case CMD_WP:
+    case CMD_WR:
+        if(StatusRunning){
+          if (f.type == CMD_WP ? profile_load_steps(&f) : profile_load_ramp(&f)) {
+            ack_receiving_speed_frames();
+          } else {
+            Serial.println("<err,1,prf>");
+          }
+          ret = RUNNING;
+        }
+        else
+        ret = READY;
+        break;
+    case CMD_SR:
+        // Accepted whether running or not, takes effect at once
+        if (!sampling_rates(&f))
+            Serial.println("<err,1,sr>");
+        ret = StatusRunning ? RUNNING : READY;
+        break;
     default:        
         Serial.println("Action: UNKNOWN command");
+        ret = StatusRunning ? RUNNING : READY;
     }
 
     return ret;
@@ -242,6 +214,9 @@ void printCommandType(CommandType type) {
     case CMD_STOP:  Serial.println("Type: STOP");  break;
     case CMD_WS:    Serial.println("Type: WS");    break;
     case CMD_SS:    Serial.println("Type: SS");    break;
+    case CMD_WP:    Serial.println("Type: WP");    break;
+    case CMD_WR:    Serial.println("Type: WR");    break;
+    case CMD_SR:    Serial.println("Type: SR");    break;
     default:        Serial.println("Type: UNKNOWN");
     }
 }
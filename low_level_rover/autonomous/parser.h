@@ -10,27 +10,29 @@ typedef enum  {
     CMD_START,
     CMD_STOP,
     CMD_WS,
-    CMD_SS   
+    CMD_SS,
+    CMD_WP,     // timed wheel profile
+    CMD_WR,     // wheel ramp
+    CMD_SR      // sensor channel sampling periods
 }CommandType;
 
+#define PROFILE_MAX_STEPS 8
+#define FRAME_MAX_VALUES (1 + 2 * PROFILE_MAX_STEPS)
+
 
 // --- Frame structure ---
 typedef struct  {
     CommandType type;
-    String cmd;
     int length;
     int val1;
     int val2;
+    int values[FRAME_MAX_VALUES];   // whole payload, val1 and val2 are its first two
 }Frame;
 
-#define MAX_PAYLOAD_NUM 3
-
-int scanner(String str);
-
-int parser (void);
-
+// Longest frame: <wp,17,dt,...> with 8 duty pairs, plus CR/LF
+#define FRAME_BUFFER_SIZE 112
 
-bool parseFrame(const String& inputFrame, Frame& frame);
+bool parseFrame(const char* input, uint8_t len, Frame& frame);
 
 int executeCommand(const Frame& f);
 
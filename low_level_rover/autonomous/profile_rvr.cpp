@@ -0,0 +1,145 @@
+#include "profile_rvr.h"
+#include "motors_rvr.h"
+#include "PlatformOps.h"
+
+#define PWM_MAX 255
+
+typedef enum {
+    PROFILE_IDLE,
+    PROFILE_STEPS,
+    PROFILE_RAMP
+} ProfileMode;
+
+typedef struct {
+    ProfileMode mode;
+    int16_t left[PROFILE_MAX_STEPS];
+    int16_t right[PROFILE_MAX_STEPS];
+    uint8_t count;
+    uint8_t index;
+    uint16_t step_ms;
+    unsigned long start;        // millis() at the start of the profile
+    unsigned long duration_ms;  // ramp length
+} profile_t;
+
+static profile_t profile = {PROFILE_IDLE};
+volatile bool ProfileTick = false;
+static uint8_t tick_count = 0;
+
+// ISR TIMER 0 compare A, once per millis() tick (~1.024 ms); timer0 keeps running for millis()
+ISR(TIMER0_COMPA_vect) {
+    if (++tick_count >= PROFILE_TICK_MS) {
+        tick_count = 0;
+        ProfileTick = true;
+    }
+}
+
+void profile_setup(void)
+{
+    cli();
+    OCR0A = 0x80;               // anywhere in the count, only the interrupt is used
+    TIMSK0 |= (1 << OCIE0A);
+    sei();
+}
+
+static bool duty_valid(int duty)
+{
+    return abs(duty) <= PWM_MAX;
+}
+
+bool profile_load_steps(const Frame* p_frm)
+{
+    int steps = (p_frm->length - 1) / 2;
+    if (p_frm->length < 3 || (p_frm->length - 1) % 2 != 0 || steps > PROFILE_MAX_STEPS)
+        return false;
+    int step_ms = p_frm->values[0];
+    if (step_ms < PROFILE_TICK_MS || step_ms > PROFILE_MAX_STEP_MS)
+        return false;
+    for (int i = 0; i < steps; i++) {
+        if (!duty_valid(p_frm->values[1 + 2 * i]) || !duty_valid(p_frm->values[2 + 2 * i]))
+            return false;
+    }
+
+    for (int i = 0; i < steps; i++) {
+        profile.left[i] = (int16_t)p_frm->values[1 + 2 * i];
+        profile.right[i] = (int16_t)p_frm->values[2 + 2 * i];
+    }
+    profile.count = (uint8_t)steps;
+    profile.index = 0;
+    profile.step_ms = (uint16_t)step_ms;
+    profile.start = millis();
+    profile.mode = PROFILE_STEPS;
+    motors_set_duty(profile.left[0], profile.right[0]);
+    return true;
+}
+
+bool profile_load_ramp(const Frame* p_frm)
+{
+    if (p_frm->length != 3 || !duty_valid(p_frm->val1) || !duty_valid(p_frm->val2) || p_frm->values[2] < PROFILE_MIN_RATE)
+        return false;
+
+    int from_left, from_right;
+    motors_get_duty(&from_left, &from_right);
+    int change = max(abs(p_frm->val1 - from_left), abs(p_frm->val2 - from_right));
+
+    // Entry 0 is where the ramp starts, entry 1 its target
+    profile.left[0] = (int16_t)from_left;
+    profile.right[0] = (int16_t)from_right;
+    profile.left[1] = (int16_t)p_frm->val1;
+    profile.right[1] = (int16_t)p_frm->val2;
+    profile.duration_ms = 1000UL * (unsigned long)change / (unsigned long)p_frm->values[2];
+    profile.start = millis();
+    profile.mode = PROFILE_RAMP;
+    return true;
+}
+
+void profile_cancel(void)
+{
+    profile.mode = PROFILE_IDLE;
+}
+
+bool profile_active(void)
+{
+    return profile.mode != PROFILE_IDLE;
+}
+
+static int interpolate(int from, int to, unsigned long elapsed, unsigned long duration)
+{
+    return from + (int)((long)(to - from) * (long)elapsed / (long)duration);
+}
+
+/*
+* Called on every ProfileTick, setpoints follow millis() so a late tick does not stretch the profile
+*/
+void profile_update(void)
+{
+    unsigned long elapsed = millis() - profile.start;
+
+    switch (profile.mode) {
+    case PROFILE_STEPS: {
+        unsigned long index = elapsed / profile.step_ms;
+        if (index >= profile.count) {
+            profile.mode = PROFILE_IDLE;
+            break;
+        }
+        if (index != profile.index) {
+            profile.index = (uint8_t)index;
+            motors_set_duty(profile.left[index], profile.right[index]);
+        }
+        break;
+    }
+    case PROFILE_RAMP:
+        if (elapsed >= profile.duration_ms) {
+            motors_set_duty(profile.left[1], profile.right[1]);
+            profile.mode = PROFILE_IDLE;
+            break;
+        }
+        motors_set_duty(interpolate(profile.left[0], profile.left[1], elapsed, profile.duration_ms),
+                        interpolate(profile.right[0], profile.right[1], elapsed, profile.duration_ms));
+        break;
+    default:
+        return;
+    }
+
+    // The host meant this motion, the watchdog counts from the end of the profile
+    ack_receiving_speed_frames();
+}
@@ -0,0 +1,33 @@
+#ifndef __PROFILE_RVR_H__
+#define __PROFILE_RVR_H__
+
+#include <Arduino.h>
+#include "parser.h"
+
+/*
+ * Wheel profiles executed by the MCU, so smooth speed changes need a single frame:
+ *
+ *  <wp,N,dt,l1,r1,...,lk,rk>  duties (l, r) held dt ms each, N = 1 + 2k, k <= PROFILE_MAX_STEPS
+ *  <wr,3,l,r,rate>            ramp to the duties (l, r), the wheel with the larger change
+ *                             moves at rate duty units per second, both arrive together
+ *
+ * The last setpoint is kept when the profile ends. The speed frame watchdog is fed while
+ * a profile runs and resumes from its end; <ws>, <start> and <stop> cancel the profile.
+ */
+
+#define PROFILE_TICK_MS 10          // profile evaluation period
+#define PROFILE_MAX_STEP_MS 1000
+#define PROFILE_MIN_RATE 50         // duty/s, bounds a ramp to about 10 s
+
+void profile_setup(void);
+
+bool profile_load_steps(const Frame* p_frm);
+bool profile_load_ramp(const Frame* p_frm);
+void profile_cancel(void);
+
+void profile_update(void);
+bool profile_active(void);
+
+extern volatile bool ProfileTick;
+
+#endif // __PROFILE_RVR_H__
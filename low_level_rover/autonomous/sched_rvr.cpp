@@ -0,0 +1,86 @@
+#include "sched_rvr.h"
+
+typedef struct {
+    sched_task_t task;
+    uint16_t period_ms;         // 0 when off
+    unsigned long due;          // millis() of the next run
+} sched_channel_t;
+
+static sched_channel_t channels[SENSOR_CHANNEL_COUNT];
+
+static bool period_valid(int period_ms)
+{
+    return period_ms == -1 || period_ms == 0 || (period_ms >= SCHED_MIN_PERIOD_MS && period_ms <= SCHED_MAX_PERIOD_MS);
+}
+
+void sched_attach(SensorChannel channel, sched_task_t task, uint16_t period_ms)
+{
+    channels[channel].task = task;
+    sched_set_period(channel, period_ms);
+}
+
+void sched_set_period(SensorChannel channel, uint16_t period_ms)
+{
+    channels[channel].period_ms = period_ms;
+    channels[channel].due = millis() + period_ms;
+}
+
+uint16_t sched_period(SensorChannel channel)
+{
+    return channels[channel].period_ms;
+}
+
+bool sched_load_rates(const Frame* p_frm)
+{
+    if (p_frm->length < 1 || p_frm->length > SENSOR_CHANNEL_COUNT)
+        return false;
+    for (int i = 0; i < p_frm->length; i++) {
+        if (!period_valid(p_frm->values[i]))
+            return false;
+    }
+
+    for (int i = 0; i < p_frm->length; i++) {
+        if (p_frm->values[i] >= 0)
+            sched_set_period((SensorChannel)i, (uint16_t)p_frm->values[i]);
+    }
+    return true;
+}
+
+void sched_restart(void)
+{
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        channels[i].due = now + channels[i].period_ms;
+}
+
+static bool channel_due(const sched_channel_t& channel, unsigned long now)
+{
+    return channel.period_ms != 0 && channel.task != NULL && (long)(now - channel.due) >= 0;
+}
+
+bool sched_pending(void)
+{
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++) {
+        if (channel_due(channels[i], now))
+            return true;
+    }
+    return false;
+}
+
+void sched_run(void)
+{
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++) {
+        sched_channel_t& channel = channels[i];
+        if (!channel_due(channel, now))
+            continue;
+
+        channel.task();
+        channel.due += channel.period_ms;
+        if ((long)(now - channel.due) >= 0) {
+            // Overran by more than a period, keep the phase from now on
+            channel.due = now + channel.period_ms;
+        }
+    }
+}
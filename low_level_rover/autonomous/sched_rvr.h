@@ -0,0 +1,40 @@
+#ifndef __SCHED_RVR_H__
+#define __SCHED_RVR_H__
+
+#include <Arduino.h>
+#include "parser.h"
+
+/*
+ * Cooperative scheduler of the sensor channels, each sampled and sent at its own period:
+ *
+ *  <sr,3,imu,ir,temp>  periods in ms, 0 turns the channel off, -1 keeps it
+ *
+ * e.g. <sr,3,5,40,1000> for the IMU at 200 Hz, the IR at 25 Hz and the temperature at 1 Hz.
+ * <start,1,N> sets the IR period. Tasks run from the main loop, one pass each when due,
+ * and must not block; a task that falls behind skips the missed periods instead of
+ * running back to back.
+ */
+
+typedef enum {
+    SENSOR_CHANNEL_IMU,
+    SENSOR_CHANNEL_IR,
+    SENSOR_CHANNEL_TEMP,
+    SENSOR_CHANNEL_COUNT
+} SensorChannel;
+
+#define SCHED_MIN_PERIOD_MS 2
+#define SCHED_MAX_PERIOD_MS 10000
+
+typedef void (*sched_task_t)(void);
+
+void sched_attach(SensorChannel channel, sched_task_t task, uint16_t period_ms);
+
+void sched_set_period(SensorChannel channel, uint16_t period_ms);
+uint16_t sched_period(SensorChannel channel);
+bool sched_load_rates(const Frame* p_frm);
+
+void sched_restart(void);
+bool sched_pending(void);
+void sched_run(void);
+
+#endif // __SCHED_RVR_H__
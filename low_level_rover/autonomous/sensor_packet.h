@@ -0,0 +1,88 @@
+#ifndef __SENSOR_PACKET_H__
+#define __SENSOR_PACKET_H__
+
+#include <Arduino.h>
+
+/*
+ * Binary sensor samples, a fraction of the characters of the ASCII lines:
+ *
+ *  0xA5 0x5A type length payload[length] ckA ckB
+ *
+ * The type tells the payload, one per sensor channel (sched_rvr.h). Type 0x01, a whole
+ * sample in one packet, was sent by earlier firmware and is still decoded by the host.
+ * Fields are little endian as laid out by the AVR. ckA/ckB is the 8-bit Fletcher sum over
+ * type, length and payload. Status and error messages stay ASCII lines; the host tells
+ * both apart by the sync bytes (liblrn/sensor-stream.hpp).
+ *
+ * Build with SENSOR_OUTPUT_ASCII 1 to get the readable "<ir,3,..><time,1,..>" lines back,
+ * e.g. for the serial monitor.
+ */
+
+#ifndef SENSOR_OUTPUT_ASCII
+#define SENSOR_OUTPUT_ASCII 0
+#endif
+
+#define SENSOR_PACKET_SYNC0 0xA5
+#define SENSOR_PACKET_SYNC1 0x5A
+#define SENSOR_PACKET_IMU 0x02        // imu_packet_t
+#define SENSOR_PACKET_IR 0x03         // ir_packet_t
+#define SENSOR_PACKET_TEMP 0x04       // temp_packet_t
+
+typedef struct __attribute__((packed)) {
+    uint8_t sync[2];
+    uint8_t type;
+    uint8_t length;
+    int16_t acc[3];             // raw BMI323
+    int16_t gyr[3];
+    uint32_t sensor_time;
+    uint8_t ck_a;
+    uint8_t ck_b;
+} imu_packet_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t sync[2];
+    uint8_t type;
+    uint8_t length;
+    uint16_t ir[3];             // raw ADC
+    uint32_t sensor_time;
+    uint8_t ck_a;
+    uint8_t ck_b;
+} ir_packet_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t sync[2];
+    uint8_t type;
+    uint8_t length;
+    int16_t temperature;        // raw BMI323
+    uint32_t sensor_time;
+    uint8_t ck_a;
+    uint8_t ck_b;
+} temp_packet_t;
+
+// Header and checksum around the payload
+#define SENSOR_PACKET_OVERHEAD 6
+
+static_assert(sizeof(imu_packet_t) == 22, "sensor packet layout is shared with the host decoder");
+static_assert(sizeof(ir_packet_t) == 16, "sensor packet layout is shared with the host decoder");
+static_assert(sizeof(temp_packet_t) == 12, "sensor packet layout is shared with the host decoder");
+
+/*
+ * Fills in the header and the checksum of a packet of the given size whose payload is set
+ */
+static inline void sensor_packet_seal(uint8_t* bytes, uint8_t size, uint8_t type) {
+    uint8_t a = 0;
+    uint8_t b = 0;
+
+    bytes[0] = SENSOR_PACKET_SYNC0;
+    bytes[1] = SENSOR_PACKET_SYNC1;
+    bytes[2] = type;
+    bytes[3] = size - SENSOR_PACKET_OVERHEAD;
+    for (uint8_t i = 2; i < size - 2; i++) {
+        a += bytes[i];
+        b += a;
+    }
+    bytes[size - 2] = a;
+    bytes[size - 1] = b;
+}
+
+#endif // __SENSOR_PACKET_H__
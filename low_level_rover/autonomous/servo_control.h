@@ -6,9 +6,7 @@
 #include "parser.h"
 extern SoftServo servo;
 
-int parser_servo(String* data);
-
-int parser_servo_cam(Frame * p_frm);
+int parser_servo_cam(const Frame * p_frm);
 
 #endif // __SERVO_CONTROL_H__
 
@@ -0,0 +1,123 @@
+#include "twi_rvr.h"
+#include <util/twi.h>
+
+static volatile twi_state_t state = TWI_IDLE;
+static uint8_t slave;
+static uint8_t tx_buffer[TWI_BUFFER_SIZE];
+static volatile uint8_t tx_length;
+static volatile uint8_t tx_index;
+static uint8_t* volatile rx_buffer;
+static volatile uint8_t rx_length;
+static volatile uint8_t rx_index;
+
+#define TWI_CONTINUE ((1 << TWINT) | (1 << TWEN) | (1 << TWIE))
+
+void twi_setup(uint32_t frequency)
+{
+    // Internal pull-ups, as Wire.begin() does
+    digitalWrite(SDA, HIGH);
+    digitalWrite(SCL, HIGH);
+
+    TWSR = 0;   // prescaler 1
+    TWBR = (uint8_t)(((F_CPU / frequency) - 16) / 2);
+    TWCR = (1 << TWEN);
+    state = TWI_IDLE;
+}
+
+bool twi_start_transfer(uint8_t address, const uint8_t* tx, uint8_t tx_len, uint8_t* rx, uint8_t rx_len)
+{
+    // The stop condition of the previous transfer may still be on the bus
+    if (state == TWI_BUSY || (TWCR & (1 << TWSTO)) || tx_len > TWI_BUFFER_SIZE)
+        return false;
+
+    slave = address;
+    memcpy(tx_buffer, tx, tx_len);
+    tx_length = tx_len;
+    tx_index = 0;
+    rx_buffer = rx;
+    rx_length = rx_len;
+    rx_index = 0;
+    state = TWI_BUSY;
+    TWCR = TWI_CONTINUE | (1 << TWSTA);
+    return true;
+}
+
+twi_state_t twi_poll(void)
+{
+    return state;
+}
+
+bool twi_transfer(uint8_t address, const uint8_t* tx, uint8_t tx_len, uint8_t* rx, uint8_t rx_len, uint16_t timeout_ms)
+{
+    unsigned long start = millis();
+    while (!twi_start_transfer(address, tx, tx_len, rx, rx_len)) {
+        if (millis() - start > timeout_ms)
+            return false;
+    }
+    while (state == TWI_BUSY) {
+        if (millis() - start > timeout_ms) {
+            // Release the bus, the next transfer starts from scratch
+            TWCR = 0;
+            TWCR = (1 << TWEN);
+            state = TWI_ERROR;
+            return false;
+        }
+    }
+    return state == TWI_DONE;
+}
+
+static void twi_stop(twi_state_t result)
+{
+    TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+    state = result;
+}
+
+ISR(TWI_vect)
+{
+    switch (TW_STATUS) {
+    case TW_START:
+    case TW_REP_START:
+        // Writes first, reads after the repeated start
+        TWDR = (tx_index < tx_length || rx_length == 0) ? (uint8_t)(slave << 1) | TW_WRITE : (uint8_t)(slave << 1) | TW_READ;
+        TWCR = TWI_CONTINUE;
+        break;
+
+    case TW_MT_SLA_ACK:
+    case TW_MT_DATA_ACK:
+        if (tx_index < tx_length) {
+            TWDR = tx_buffer[tx_index++];
+            TWCR = TWI_CONTINUE;
+        } else if (rx_length > 0) {
+            TWCR = TWI_CONTINUE | (1 << TWSTA);
+        } else {
+            twi_stop(TWI_DONE);
+        }
+        break;
+
+    case TW_MR_SLA_ACK:
+        // ACK every byte but the last
+        TWCR = rx_length > 1 ? TWI_CONTINUE | (1 << TWEA) : TWI_CONTINUE;
+        break;
+
+    case TW_MR_DATA_ACK:
+        rx_buffer[rx_index++] = TWDR;
+        TWCR = rx_index < rx_length - 1 ? TWI_CONTINUE | (1 << TWEA) : TWI_CONTINUE;
+        break;
+
+    case TW_MR_DATA_NACK:
+        rx_buffer[rx_index++] = TWDR;
+        twi_stop(TWI_DONE);
+        break;
+
+    case TW_MT_ARB_LOST:
+        // Bus released without a stop
+        TWCR = (1 << TWINT) | (1 << TWEN);
+        state = TWI_ERROR;
+        break;
+
+    default:
+        // Address or data not acknowledged, bus error
+        twi_stop(TWI_ERROR);
+        break;
+    }
+}
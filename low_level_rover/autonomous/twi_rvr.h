@@ -0,0 +1,30 @@
+#ifndef __TWI_RVR_H__
+#define __TWI_RVR_H__
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/*
+ * Interrupt-driven I2C master, replaces Wire so a transaction runs in the background:
+ * twi_start_transfer() queues a write of tx followed, after a repeated start, by a read
+ * into rx, and returns at once; the TWI interrupt moves the bytes. twi_poll() tells when
+ * it is over. twi_transfer() waits for it, for the configuration done at start-up.
+ */
+
+#define TWI_BUFFER_SIZE 32
+
+typedef enum {
+    TWI_IDLE,
+    TWI_BUSY,
+    TWI_DONE,
+    TWI_ERROR
+} twi_state_t;
+
+void twi_setup(uint32_t frequency);
+
+bool twi_start_transfer(uint8_t address, const uint8_t* tx, uint8_t tx_len, uint8_t* rx, uint8_t rx_len);
+twi_state_t twi_poll(void);
+
+bool twi_transfer(uint8_t address, const uint8_t* tx, uint8_t tx_len, uint8_t* rx, uint8_t rx_len, uint16_t timeout_ms);
+
+#endif // __TWI_RVR_H__
@@ -0,0 +1,110 @@
+#include "hal.hpp"
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <thread>
+
+volatile uint8_t SREG;
+volatile uint8_t TCCR0A, TCCR0B, TCNT0, OCR0A, OCR0B, TIMSK0;
+volatile uint8_t TCCR1A, TCCR1B, TIMSK1;
+volatile uint16_t OCR1A, TCNT1;
+volatile uint8_t TCCR2A, TCCR2B, TCNT2, OCR2A, TIMSK2, TIFR2;
+volatile uint8_t TCCR3A, TCCR3B;
+volatile uint16_t ICR3, OCR3A, OCR3B, OCR3C;
+volatile uint8_t ADMUX, ADCSRA, ADCSRB, ADCL, ADCH;
+
+volatile uint8_t hal_port_registers[NUM_DIGITAL_PINS];
+
+// Vectors the firmware may or may not define
+extern "C" void TIMER0_COMPA_vect(void) __attribute__((weak));
+extern "C" void ADC_vect(void) __attribute__((weak));
+
+namespace {
+
+const auto start = std::chrono::steady_clock::now();
+
+constexpr unsigned long timer0_tick_us = 1024;             // 64 * 256 / 16 MHz
+constexpr unsigned long adc_conversion_us = 13 * 128 * 1000000UL / F_CPU;
+constexpr unsigned long max_catch_up_ticks = 10;
+
+uint8_t pin_values[NUM_DIGITAL_PINS];
+unsigned long timer0_stamp = 0;
+unsigned long adc_stamp = 0;
+
+} // namespace
+
+// 32 bits like the AVR, so the firmware's wrap-around arithmetic is exercised
+unsigned long millis(void) {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+unsigned long micros(void) {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+void delay(unsigned long ms) {
+    const unsigned long begin = millis();
+    while (static_cast<uint32_t>(millis() - begin) < ms) {
+        hal_run_interrupts();
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+}
+
+void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void pinMode(uint8_t /*pin*/, uint8_t /*mode*/) {
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < NUM_DIGITAL_PINS) {
+        pin_values[pin] = value ? HIGH : LOW;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < NUM_DIGITAL_PINS ? pin_values[pin] : LOW;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+void hal_run_interrupts(void) {
+    const unsigned long now = micros();
+
+    unsigned long ticks = static_cast<uint32_t>(now - timer0_stamp) / timer0_tick_us;
+    if (ticks > max_catch_up_ticks) {
+        // The host was descheduled, do not replay the whole gap
+        timer0_stamp = now - max_catch_up_ticks * timer0_tick_us;
+        ticks = max_catch_up_ticks;
+    }
+    for (; ticks > 0; ticks--) {
+        timer0_stamp += timer0_tick_us;
+        if ((TIMSK0 & (1 << OCIE0A)) && TIMER0_COMPA_vect) {
+            TIMER0_COMPA_vect();
+        }
+    }
+
+    if ((ADCSRA & (1 << ADEN)) && (ADCSRA & (1 << ADSC))) {
+        if (static_cast<uint32_t>(now - adc_stamp) >= adc_conversion_us) {
+            adc_stamp = now;
+            const uint16_t value = sim_adc_sample(ADMUX & 0x07);
+            ADCL = static_cast<uint8_t>(value & 0xFF);
+            ADCH = static_cast<uint8_t>(value >> 8);
+            ADCSRA &= static_cast<uint8_t>(~(1 << ADSC));
+            if ((ADCSRA & (1 << ADIE)) && ADC_vect) {
+                ADC_vect();
+            }
+        }
+    } else {
+        adc_stamp = now;
+    }
+}
+
+void hal_idle(void) {
+    Serial.poll();
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+
+// Host side of the mock HAL, driven by main.cpp
+
+/**
+ * @brief Calls the interrupt vectors that are due: timer 0 compare A every 1.024 ms and
+ * the ADC conversion complete every 104 us, while the firmware has them enabled.
+ *
+ * Timer 2 (SoftPWM) is not run, only the camera servo hangs on it.
+ */
+void hal_run_interrupts(void);
+
+/**
+ * @brief Moves the bytes due on the wire to the pty and waits a little.
+ */
+void hal_idle(void);
+
+// Sensor models, sensor-sim.cpp
+
+/**
+ * @brief ADC result of a multiplexer channel, 10 bits.
+ */
+uint16_t sim_adc_sample(uint8_t channel);
@@ -0,0 +1,63 @@
+#pragma once
+
+// Mock of the Arduino core for the host build of the autonomous firmware (see README.md).
+// Only what the firmware uses; the board is an ATmega2560.
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+
+#define LED_BUILTIN 13
+#define SDA 20
+#define SCL 21
+#define A0 54
+#define A1 55
+#define A2 56
+#define NUM_DIGITAL_PINS 70
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+// Functions rather than the core's macros, which would break the standard headers
+template<class T, class U> inline auto min(T a, U b) -> decltype(a < b ? a : b) { return a < b ? a : b; }
+template<class T, class U> inline auto max(T a, U b) -> decltype(a > b ? a : b) { return a > b ? a : b; }
+template<class T, class U, class V> inline T constrain(T x, U low, V high) { return x < low ? low : x > high ? high : x; }
+
+#define noInterrupts() cli()
+#define interrupts() sei()
+
+// Direct port access of SoftPWM, one emulated output register per pin
+#define digitalPinToPort(pin) (pin)
+#define digitalPinToBitMask(pin) ((uint8_t)1)
+#define portOutputRegister(port) (&hal_port_registers[(port) % NUM_DIGITAL_PINS])
+#define portModeRegister(port) (&hal_port_registers[(port) % NUM_DIGITAL_PINS])
+extern volatile uint8_t hal_port_registers[NUM_DIGITAL_PINS];
+
+#include "HardwareSerial.h"
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * UART 0 backed by a pseudo-terminal. begin() opens the master side; the host connects
+ * to the slave, whose path is printed and optionally symlinked (hal_serial_link()).
+ * Writes are paced at the baud rate through a SERIAL_TX_BUFFER_SIZE buffer, like the
+ * interrupt-driven AVR UART: availableForWrite() shrinks as bytes are queued and write()
+ * waits once it is full. poll() moves the bytes due on the wire, from the main loop.
+ */
+
+#define SERIAL_TX_BUFFER_SIZE 64
+#define SERIAL_RX_BUFFER_SIZE 64
+
+class HardwareSerial {
+public:
+    void begin(unsigned long baud);
+
+    int available(void);
+    int read(void);
+    int availableForWrite(void);
+
+    size_t write(uint8_t byte);
+    size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* buffer, size_t size) { return write(reinterpret_cast<const uint8_t*>(buffer), size); }
+
+    size_t print(const char* s);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC_BASE);
+    size_t print(int value, int base = DEC_BASE);
+    size_t print(unsigned int value, int base = DEC_BASE);
+    size_t print(long value, int base = DEC_BASE);
+    size_t print(unsigned long value, int base = DEC_BASE);
+    size_t print(double value, int digits = 2);
+
+    size_t println(void);
+    template<class T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template<class T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+    void poll(void);
+
+private:
+    static constexpr int DEC_BASE = 10;
+
+    void fill_rx(void);
+    void drain_tx(void);
+
+    int fd_ = -1;
+    unsigned long baud_ = 115200;
+    uint8_t rx_[SERIAL_RX_BUFFER_SIZE];
+    size_t rx_head_ = 0;
+    size_t rx_count_ = 0;
+    uint8_t tx_[SERIAL_TX_BUFFER_SIZE];
+    size_t tx_head_ = 0;
+    size_t tx_count_ = 0;
+    double tx_credit_ = 0.0;        // bytes the wire could have sent since the last drain
+    unsigned long tx_stamp_ = 0;    // micros() of the last drain
+};
+
+extern HardwareSerial Serial;
+
+// Path of a symlink to the pty slave, created by begin(); nullptr for none
+void hal_serial_link(const char* path);
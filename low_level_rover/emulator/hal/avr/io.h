@@ -0,0 +1,53 @@
+#pragma once
+
+// ATmega2560 registers used by the firmware, plain memory on the host. Peripherals that
+// matter are emulated by hal.cpp from what the firmware writes here.
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+extern volatile uint8_t SREG;
+
+// Timer 0 (millis, profile tick)
+extern volatile uint8_t TCCR0A, TCCR0B, TCNT0, OCR0A, OCR0B, TIMSK0;
+#define OCIE0A 1
+
+// Timer 1
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1;
+extern volatile uint16_t OCR1A, TCNT1;
+#define WGM12 3
+#define CS10 0
+#define CS12 2
+#define OCIE1A 1
+
+// Timer 2 (SoftPWM)
+extern volatile uint8_t TCCR2A, TCCR2B, TCNT2, OCR2A, TIMSK2, TIFR2;
+#define WGM21 1
+#define CS21 1
+#define OCIE2A 1
+#define TOV2 0
+
+// Timer 3 (motor PWM)
+extern volatile uint8_t TCCR3A, TCCR3B;
+extern volatile uint16_t ICR3, OCR3A, OCR3B, OCR3C;
+#define WGM30 0
+#define WGM31 1
+#define WGM32 3
+#define WGM33 4
+#define CS30 0
+#define COM3C1 3
+#define COM3B1 5
+#define COM3A1 7
+
+// ADC
+extern volatile uint8_t ADMUX, ADCSRA, ADCSRB, ADCL, ADCH;
+#define REFS0 6
+#define ADEN 7
+#define ADSC 6
+#define ADIE 3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
@@ -0,0 +1,26 @@
+// Runs the autonomous firmware on the host against the mock Arduino HAL, its serial port
+// on a pseudo-terminal. See README.md.
+//
+//     lunar-rover-emulator [link]
+//
+// link: path of a symlink to the pty slave, e.g. /tmp/ttyROVER, for platform.port
+
+#include <Arduino.h>
+
+#include "hal.hpp"
+
+void setup(void);
+void loop(void);
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        hal_serial_link(argv[1]);
+    }
+
+    setup();
+    for (;;) {
+        hal_run_interrupts();
+        loop();
+        hal_idle();
+    }
+}
@@ -0,0 +1,264 @@
+// Replaces twi_rvr.cpp: transfers go to a model of the BMI323 instead of the TWI hardware,
+// and take as long as they would on the bus. Also the IR sensors behind the ADC.
+
+#include <Arduino.h>
+
+#include "hal.hpp"
+
+#include "bmi323.h"
+#include "motors_rvr.h"
+#include "twi_rvr.h"
+
+namespace {
+
+constexpr uint8_t bmi323_address = BMI323_I2C_ADDR_PRIMARY;
+constexpr uint16_t acc_conf_reset = 0x0028;     // 100 Hz, suspended
+constexpr uint16_t fifo_capacity_frames = BMI323_FIFO_CAPACITY_WORDS / BMI323_FIFO_FRAME_WORDS;
+constexpr double gyro_lsb_per_dps = 32.768;     // +-1000 dps range
+constexpr double max_turn_dps = 120.0;          // both wheels at full duty, opposite directions
+constexpr int16_t gravity_lsb = 8190;           // +-4 g range
+constexpr int16_t temperature_raw = 1024;       // 25 degC
+
+struct Bmi323 {
+    uint16_t acc_conf = acc_conf_reset;
+    uint16_t gyr_conf = acc_conf_reset;
+    uint16_t fifo_watermark = 0;
+    uint16_t fifo_conf = 0;
+
+    // FIFO frames are numbered from fifo_base_us at the accelerometer ODR
+    unsigned long fifo_base_us = 0;
+    uint32_t fifo_read = 0;
+};
+
+Bmi323 imu;
+
+uint32_t twi_frequency = 100000;
+twi_state_t twi_state = TWI_IDLE;
+twi_state_t twi_result = TWI_DONE;
+unsigned long twi_start_us = 0;
+unsigned long twi_duration_us = 0;
+
+double odr_hz(uint16_t conf) {
+    return 100.0 * pow(2.0, static_cast<int>(conf & BMI323_CONF_ODR_MASK) - 8);
+}
+
+uint32_t sensor_time(unsigned long us) {
+    // 39.0625 us ticks
+    return static_cast<uint32_t>(static_cast<uint64_t>(us) * 16 / 625);
+}
+
+int16_t gyro_z(void) {
+    int left;
+    int right;
+    motors_get_duty(&left, &right);
+    const double dps = static_cast<double>(right - left) / 510.0 * max_turn_dps;
+    return static_cast<int16_t>(dps * gyro_lsb_per_dps + (rand() % 7 - 3));
+}
+
+uint16_t fifo_written(unsigned long now) {
+    if (imu.fifo_conf == 0) {
+        return 0;
+    }
+    const auto produced = static_cast<uint32_t>(static_cast<double>(static_cast<uint32_t>(now - imu.fifo_base_us)) * odr_hz(imu.acc_conf) / 1e6);
+    if (produced - imu.fifo_read > fifo_capacity_frames) {
+        // Stream mode, the oldest frames are overwritten
+        imu.fifo_read = produced - fifo_capacity_frames;
+    }
+    return static_cast<uint16_t>(produced - imu.fifo_read);
+}
+
+void fifo_reset(unsigned long now) {
+    imu.fifo_base_us = now;
+    imu.fifo_read = 0;
+}
+
+uint16_t read_register(uint8_t reg, unsigned long now) {
+    switch (reg) {
+    case BMI323_REG_CHIP_ID:
+        return BMI323_CHIP_ID_VALUE;
+    case BMI323_REG_STATUS:
+        return 0x00E0;      // acc, gyr and temperature data ready
+    case BMI323_REG_ACC_DATA_X:
+    case BMI323_REG_ACC_DATA_Y:
+        return static_cast<uint16_t>(rand() % 21 - 10);
+    case BMI323_REG_ACC_DATA_Z:
+        return static_cast<uint16_t>(gravity_lsb + rand() % 21 - 10);
+    case BMI323_REG_GYR_DATA_X:
+    case BMI323_REG_GYR_DATA_Y:
+        return static_cast<uint16_t>(rand() % 7 - 3);
+    case BMI323_REG_GYR_DATA_Z:
+        return static_cast<uint16_t>(gyro_z());
+    case BMI323_REG_TEMP_DATA:
+        return static_cast<uint16_t>(temperature_raw);
+    case BMI323_REG_SENSOR_TIME_0:
+        return static_cast<uint16_t>(sensor_time(now));
+    case BMI323_REG_SENSOR_TIME_1:
+        return static_cast<uint16_t>(sensor_time(now) >> 16);
+    case BMI323_REG_FIFO_FILL_LEVEL:
+        return static_cast<uint16_t>(fifo_written(now) * BMI323_FIFO_FRAME_WORDS);
+    case BMI323_REG_ACC_CONF:
+        return imu.acc_conf;
+    case BMI323_REG_GYR_CONF:
+        return imu.gyr_conf;
+    case BMI323_REG_FIFO_WATERMARK:
+        return imu.fifo_watermark;
+    case BMI323_REG_FIFO_CONF:
+        return imu.fifo_conf;
+    default:
+        return 0;
+    }
+}
+
+void read_fifo(uint8_t* rx, uint8_t length, unsigned long now) {
+    uint16_t frames = fifo_written(now);
+    const double period_us = 1e6 / odr_hz(imu.acc_conf);
+    uint8_t words[BMI323_FIFO_FRAME_WORDS * 2];
+
+    for (uint8_t i = 0; i < length; i++) {
+        const uint8_t offset = i % BMI323_FIFO_FRAME_BYTES;
+        if (offset == 0) {
+            uint16_t frame[BMI323_FIFO_FRAME_WORDS] = {BMI323_FIFO_DUMMY_ACC, 0, 0, 0, 0, 0, 0, 0};
+            if (frames > 0) {
+                const auto stamp = static_cast<unsigned long>(imu.fifo_base_us + static_cast<unsigned long>((imu.fifo_read + 1) * period_us));
+                frame[0] = read_register(BMI323_REG_ACC_DATA_X, now);
+                frame[1] = read_register(BMI323_REG_ACC_DATA_Y, now);
+                frame[2] = read_register(BMI323_REG_ACC_DATA_Z, now);
+                frame[3] = read_register(BMI323_REG_GYR_DATA_X, now);
+                frame[4] = read_register(BMI323_REG_GYR_DATA_Y, now);
+                frame[5] = read_register(BMI323_REG_GYR_DATA_Z, now);
+                frame[6] = static_cast<uint16_t>(temperature_raw);
+                frame[7] = static_cast<uint16_t>(sensor_time(stamp));
+                imu.fifo_read++;
+                frames--;
+            }
+            for (uint8_t w = 0; w < BMI323_FIFO_FRAME_WORDS; w++) {
+                words[2 * w] = static_cast<uint8_t>(frame[w] & 0xFF);
+                words[2 * w + 1] = static_cast<uint8_t>(frame[w] >> 8);
+            }
+        }
+        rx[i] = words[offset];
+    }
+}
+
+void write_register(uint8_t reg, uint16_t value, unsigned long now) {
+    switch (reg) {
+    case BMI323_REG_CMD:
+        if (value == BMI323_CMD_SOFT_RESET) {
+            imu = Bmi323{};
+        }
+        break;
+    case BMI323_REG_ACC_CONF:
+        if ((value ^ imu.acc_conf) & BMI323_CONF_ODR_MASK) {
+            fifo_reset(now);
+        }
+        imu.acc_conf = value;
+        break;
+    case BMI323_REG_GYR_CONF:
+        imu.gyr_conf = value;
+        break;
+    case BMI323_REG_FIFO_WATERMARK:
+        imu.fifo_watermark = value;
+        break;
+    case BMI323_REG_FIFO_CONF:
+        imu.fifo_conf = value;
+        fifo_reset(now);
+        break;
+    case BMI323_REG_FIFO_CTRL:
+        if (value & BMI323_FIFO_CTRL_FLUSH) {
+            imu.fifo_read += fifo_written(now);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void transfer(const uint8_t* tx, uint8_t tx_len, uint8_t* rx, uint8_t rx_len, unsigned long now) {
+    if (tx_len >= 3) {
+        write_register(tx[0], static_cast<uint16_t>(tx[1] | (tx[2] << 8)), now);
+    }
+    if (tx_len == 0 || rx_len == 0) {
+        return;
+    }
+
+    // Two dummy bytes, then little-endian words from the auto-incremented address
+    const uint8_t reg = tx[0];
+    if (reg == BMI323_REG_FIFO_DATA) {
+        memset(rx, 0, rx_len < 2 ? rx_len : 2);
+        if (rx_len > 2) {
+            read_fifo(rx + 2, static_cast<uint8_t>(rx_len - 2), now);
+        }
+        return;
+    }
+    for (uint8_t i = 0; i < rx_len; i++) {
+        if (i < 2) {
+            rx[i] = 0;
+            continue;
+        }
+        const uint8_t word = static_cast<uint8_t>((i - 2) / 2);
+        const uint16_t value = read_register(static_cast<uint8_t>(reg + word), now);
+        rx[i] = static_cast<uint8_t>((i - 2) % 2 == 0 ? value & 0xFF : value >> 8);
+    }
+}
+
+} // namespace
+
+void twi_setup(uint32_t frequency) {
+    twi_frequency = frequency;
+    twi_state = TWI_IDLE;
+}
+
+bool twi_start_transfer(uint8_t address, const uint8_t* tx, uint8_t tx_len, uint8_t* rx, uint8_t rx_len) {
+    if (twi_state == TWI_BUSY || tx_len > TWI_BUFFER_SIZE) {
+        return false;
+    }
+
+    const unsigned long now = micros();
+    if (address == bmi323_address) {
+        transfer(tx, tx_len, rx, rx_len, now);
+        twi_result = TWI_DONE;
+    } else {
+        // Nobody acknowledges the address
+        tx_len = 0;
+        rx_len = 0;
+        twi_result = TWI_ERROR;
+    }
+
+    // 9 clocks per byte, the address byte twice with a repeated start, and start/stop
+    const unsigned long bits = 9UL * (1 + tx_len) + (rx_len > 0 ? 9UL * (1 + rx_len) : 0) + 2;
+    twi_start_us = now;
+    twi_duration_us = bits * 1000000UL / twi_frequency;
+    twi_state = TWI_BUSY;
+    return true;
+}
+
+twi_state_t twi_poll(void) {
+    if (twi_state == TWI_BUSY && static_cast<uint32_t>(micros() - twi_start_us) >= twi_duration_us) {
+        twi_state = twi_result;
+    }
+    return twi_state;
+}
+
+bool twi_transfer(uint8_t address, const uint8_t* tx, uint8_t tx_len, uint8_t* rx, uint8_t rx_len, uint16_t timeout_ms) {
+    const unsigned long start = millis();
+    while (!twi_start_transfer(address, tx, tx_len, rx, rx_len)) {
+        if (millis() - start > timeout_ms) {
+            return false;
+        }
+        hal_run_interrupts();
+    }
+    while (twi_poll() == TWI_BUSY) {
+        hal_run_interrupts();
+    }
+    return twi_state == TWI_DONE;
+}
+
+uint16_t sim_adc_sample(uint8_t channel) {
+    // Walls at a few tens of cm, with the odd spike of a real Sharp sensor
+    static const uint16_t levels[] = {180, 220, 160};
+    int value = levels[channel % 3] + rand() % 9 - 4;
+    if (rand() % 64 == 0) {
+        value += rand() % 301 - 150;
+    }
+    return static_cast<uint16_t>(value < 0 ? 0 : value > 1023 ? 1023 : value);
+}
@@ -0,0 +1,180 @@
+#include <Arduino.h>
+
+#include "hal.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pty.h>
+#include <stdio.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+
+namespace {
+
+const char* link_path = nullptr;
+
+} // namespace
+
+void hal_serial_link(const char* path) {
+    link_path = path;
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+    baud_ = baud;
+    if (fd_ >= 0) {
+        return;
+    }
+
+    // The slave stays open, raw, so the master does not see a hang-up between host connections
+    int slave_fd;
+    struct termios tio;
+    if (openpty(&fd_, &slave_fd, nullptr, nullptr, nullptr) != 0) {
+        perror("[emulator]: cannot open a pty");
+        exit(EXIT_FAILURE);
+    }
+    if (tcgetattr(slave_fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(slave_fd, TCSANOW, &tio);
+    }
+    const char* slave = ttyname(slave_fd) != nullptr ? ttyname(slave_fd) : "an unnamed pty";
+    fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) | O_NONBLOCK);
+
+    if (link_path != nullptr) {
+        unlink(link_path);
+        if (symlink(slave, link_path) != 0) {
+            perror("[emulator]: cannot link the pty");
+        }
+    }
+    fprintf(stderr, "[emulator]: serial port on %s (%s), %lu baud\n", slave, link_path != nullptr ? link_path : "no link", baud_);
+
+    tx_stamp_ = micros();
+}
+
+void HardwareSerial::fill_rx(void) {
+    while (fd_ >= 0 && rx_count_ < SERIAL_RX_BUFFER_SIZE) {
+        uint8_t byte;
+        if (::read(fd_, &byte, 1) != 1) {
+            break;
+        }
+        rx_[(rx_head_ + rx_count_) % SERIAL_RX_BUFFER_SIZE] = byte;
+        rx_count_++;
+    }
+}
+
+void HardwareSerial::drain_tx(void) {
+    const unsigned long now = micros();
+    // 10 bits per byte on the wire, start and stop bits included
+    tx_credit_ += static_cast<double>(static_cast<uint32_t>(now - tx_stamp_)) * static_cast<double>(baud_) / 10.0e6;
+    tx_stamp_ = now;
+
+    while (tx_count_ > 0 && tx_credit_ >= 1.0) {
+        if (fd_ >= 0 && ::write(fd_, &tx_[tx_head_], 1) != 1 && errno != EAGAIN) {
+            fd_ = -1;
+        }
+        // A full pty loses the byte, like a UART nobody listens to
+        tx_head_ = (tx_head_ + 1) % SERIAL_TX_BUFFER_SIZE;
+        tx_count_--;
+        tx_credit_ -= 1.0;
+    }
+    if (tx_count_ == 0 && tx_credit_ > 1.0) {
+        // An idle wire does not save up bandwidth
+        tx_credit_ = 1.0;
+    }
+}
+
+void HardwareSerial::poll(void) {
+    fill_rx();
+    drain_tx();
+}
+
+int HardwareSerial::available(void) {
+    fill_rx();
+    return static_cast<int>(rx_count_);
+}
+
+int HardwareSerial::read(void) {
+    fill_rx();
+    if (rx_count_ == 0) {
+        return -1;
+    }
+    const uint8_t byte = rx_[rx_head_];
+    rx_head_ = (rx_head_ + 1) % SERIAL_RX_BUFFER_SIZE;
+    rx_count_--;
+    return byte;
+}
+
+int HardwareSerial::availableForWrite(void) {
+    drain_tx();
+    return static_cast<int>(SERIAL_TX_BUFFER_SIZE - tx_count_);
+}
+
+size_t HardwareSerial::write(uint8_t byte) {
+    drain_tx();
+    while (tx_count_ == SERIAL_TX_BUFFER_SIZE) {
+        // The AVR core spins the same way until the UART interrupt frees a slot
+        hal_run_interrupts();
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+        drain_tx();
+    }
+    tx_[(tx_head_ + tx_count_) % SERIAL_TX_BUFFER_SIZE] = byte;
+    tx_count_++;
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        write(buffer[i]);
+    }
+    return size;
+}
+
+size_t HardwareSerial::print(const char* s) {
+    return write(s, strlen(s));
+}
+
+size_t HardwareSerial::print(char c) {
+    return write(static_cast<uint8_t>(c));
+}
+
+size_t HardwareSerial::print(unsigned char value, int base) {
+    return print(static_cast<unsigned long>(value), base);
+}
+
+size_t HardwareSerial::print(int value, int base) {
+    return print(static_cast<long>(value), base);
+}
+
+size_t HardwareSerial::print(unsigned int value, int base) {
+    return print(static_cast<unsigned long>(value), base);
+}
+
+size_t HardwareSerial::print(long value, int base) {
+    if (base == DEC_BASE) {
+        char text[24];
+        snprintf(text, sizeof(text), "%ld", value);
+        return print(text);
+    }
+    // Other bases print the two's complement, as the Arduino core
+    return print(static_cast<unsigned long>(value), base);
+}
+
+size_t HardwareSerial::print(unsigned long value, int base) {
+    char text[24];
+    snprintf(text, sizeof(text), base == HEX ? "%lX" : "%lu", value);
+    return print(text);
+}
+
+size_t HardwareSerial::print(double value, int digits) {
+    char text[48];
+    snprintf(text, sizeof(text), "%.*f", digits, value);
+    return print(text);
+}
+
+size_t HardwareSerial::println(void) {
+    return print("\r\n");
+}
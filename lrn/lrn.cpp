@@ -34,6 +34,7 @@
 #include <fmt/format.h>
 
 #include <liblrn/lrn.hpp>
+#include <liblrn/rover.hpp>
 
 namespace po = boost::program_options;
 namespace logging = boost::log;
@@ -105,11 +106,42 @@ int lrn_process(const boost::json::value &json_config) {
     return result;
 }
 
+int lrn_calibrate_motors(const boost::json::value &json_config) {
+    int result = 0;
+    try {
+        lrn::LRnConfig config = boost::json::value_to<lrn::LRnConfig>(json_config);
+        lrn::Rover rover;
+        rover.init(config.rover);
+
+        // Ctrl-C stops the wheels and abandons the calibration
+        std::thread interrupter([&]() {
+            interrupt_execution.wait(false);
+            rover.stop();
+        });
+
+        result = rover.calibrateMotors() ? 0 : 1;
+
+        interrupt_execution = true;
+        interrupt_execution.notify_all();
+        interrupter.join();
+
+    } catch(std::exception& e) {
+        BOOST_LOG_TRIVIAL(fatal) << fmt::format("Motor calibration failed: {}", e.what());
+        result = 1;
+    }
+    catch(...) {
+        BOOST_LOG_TRIVIAL(fatal) << fmt::format("Exception of unknown type");
+        result = 1;
+    }
+    return result;
+}
+
 int main(int argc, char* argv[]) {
     
     interrupt_execution = false;
     fs::path default_config_path = fs::current_path() / "nav.json";
     std::string config_file = "";
+    bool calibrate_motors = false;
     boost::log::trivial::severity_level log_severity = logging::trivial::info;
     try{
         po::options_description desc("Allowed options");
@@ -117,6 +149,7 @@ int main(int argc, char* argv[]) {
         ("help,h", "produce help message")
         ("version,v", "show version" )
         ("config,c", po::value < std::string >(&config_file)->default_value(default_config_path.string()), "Configuration file path")
+        ("calibrate-motors", po::bool_switch(&calibrate_motors), "Fit the wheel motor tables by spinning the rover in place, then exit")
         ("log_severity,l", po::value < boost::log::trivial::severity_level >(&log_severity)->default_value(log_severity), "Logging severity level: trace, debug, info (default), warning, error, fatal")
         ;
         
@@ -177,5 +210,8 @@ int main(int argc, char* argv[]) {
         BOOST_LOG_TRIVIAL(fatal) << fmt::format("Failed to install INT signal: {}", get_strerror());
         return 2; 
     }
+    if(calibrate_motors) {
+        return lrn_calibrate_motors(json_config);
+    }
     return lrn_process(json_config);
 }
\ No newline at end of file
@@ -23,6 +23,7 @@ sensors_socket.setsockopt(zmq.SUBSCRIBE, sensorsTopicfilter)
 motorsTopic = b"motors-commands"
 tiltMotorTopic = b"tilt-motor-command"
 setupTopic = b"motors-setup"
+missionTopic = b"mission-waypoints"
 
 app = FastAPI()
 
@@ -62,6 +63,8 @@ async def remote_cli_waitable(ws: WebSocket):
             await motors_socket.send_multipart([motorsTopic, json.dumps(ddd).encode('utf-8')])
         if 'alpha' in ddd: 
             await motors_socket.send_multipart([tiltMotorTopic, json.dumps({"alpha": ddd["alpha"]}).encode('utf-8')])
+        if 'waypoints' in ddd or 'clear' in ddd:
+            await motors_socket.send_multipart([missionTopic, json.dumps(ddd).encode('utf-8')])
 
 # Websocket para obter dados em real-time
 @app.websocket("/ws")
@@ -0,0 +1,51 @@
+#include <liblrn/mpc-tracker.hpp>
+#include <liblrn/kinematics.hpp>
+
+#include <cmath>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace lrn;
+
+TEST_CASE("Tracker commands the wheels onto a straight reference", "[mpc-tracker]") {
+    RoverConfig rover_cfg {};
+    rover_cfg.wheelbase = 0.468;    // nav.json.example
+    rover_cfg.wheel_radius = 0.1;
+    MpcTrackerConfig cfg {};
+    MpcTracker tracker(rover_cfg, cfg);
+
+    // Start off the x axis and turned away from it, track y = 0 at 0.2 m/s
+    constexpr double speed = 0.2;
+    RobotState state {{0.0, 0.15}, 0.4};
+    TrackingReference reference;
+    reference.poses.resize(tracker.horizon());
+
+    WheelSpeeds<double> previous {0.0, 0.0};
+    for(int step = 0; step < 100; step++) {
+        const double t = step * tracker.dt();
+        for(std::size_t k = 0; k < reference.poses.size(); k++) {
+            reference.poses[k] = {{speed * (t + tracker.dt() * static_cast<double>(k + 1)), 0.0}, 0.0};
+        }
+
+        // What Rover::drive sends to the motors, then the motion it produces
+        const auto [v, w] = tracker.solve(state, reference);
+        const auto wheels = twist_to_wheels(v, w, rover_cfg.wheelbase, rover_cfg.wheel_radius);
+        REQUIRE(std::abs(wheels.left) <= rover_cfg.max_wheel_speed + 1e-9);
+        REQUIRE(std::abs(wheels.right) <= rover_cfg.max_wheel_speed + 1e-9);
+        const double max_step = rover_cfg.max_wheel_acceleration * tracker.dt() + 1e-9;
+        REQUIRE(std::abs(wheels.left - previous.left) <= max_step);
+        REQUIRE(std::abs(wheels.right - previous.right) <= max_step);
+        previous = wheels;
+
+        const auto [v_wheels, w_wheels] = wheels_to_twist(wheels, rover_cfg.wheelbase, rover_cfg.wheel_radius);
+        state.pos.x += v_wheels * std::cos(state.theta) * tracker.dt();
+        state.pos.y += v_wheels * std::sin(state.theta) * tracker.dt();
+        state.theta += w_wheels * tracker.dt();
+    }
+
+    const double t_end = 100 * tracker.dt();
+    CHECK(std::abs(state.pos.y) < 0.02);
+    CHECK(std::abs(state.theta) < 0.05);
+    CHECK(std::abs(state.pos.x - speed * t_end) < 0.05);
+    CHECK(tracker.statistics().solves == 100);
+}
@@ -0,0 +1,72 @@
+#include <liblrn/pose-history.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+#include <catch2/catch_test_macros.hpp>
+
+using lrn::PoseHistory;
+using lrn::RobotState;
+using namespace std::chrono_literals;
+
+namespace {
+const PoseHistory::clock::time_point t0 = PoseHistory::clock::time_point{} + 100s;
+
+bool near(double a, double b) {
+    return std::abs(a - b) < 1e-9;
+}
+}
+
+TEST_CASE("Lookups interpolate between the surrounding poses", "[pose-history]") {
+    PoseHistory history(8);
+    history.push(t0, {{0.0, 0.0}, 0.0});
+    history.push(t0 + 10ms, {{1.0, 2.0}, 0.2});
+
+    const auto mid = history.at(t0 + 2500us);
+    REQUIRE(mid);
+    CHECK(near(mid->pos.x, 0.25));
+    CHECK(near(mid->pos.y, 0.5));
+    CHECK(near(mid->theta, 0.05));
+
+    const auto last = history.at(t0 + 10ms);
+    REQUIRE(last);
+    CHECK(near(last->pos.x, 1.0));
+}
+
+TEST_CASE("Heading is interpolated along the shortest arc", "[pose-history]") {
+    using std::numbers::pi;
+    PoseHistory history(8);
+    history.push(t0, {{0.0, 0.0}, pi - 0.1});
+    history.push(t0 + 10ms, {{0.0, 0.0}, -pi + 0.1});
+
+    const auto mid = history.at(t0 + 5ms);
+    REQUIRE(mid);
+    CHECK(std::abs(std::abs(mid->theta) - pi) < 1e-9);
+}
+
+TEST_CASE("Times outside the buffer have no pose", "[pose-history]") {
+    PoseHistory history(3);
+    CHECK_FALSE(history.at(t0));
+
+    for(int i = 0; i < 5; i++) {
+        history.push(t0 + i * 10ms, {{static_cast<double>(i), 0.0}, 0.0});
+    }
+    // The two oldest were overwritten
+    CHECK_FALSE(history.at(t0 + 15ms));
+    CHECK_FALSE(history.at(t0 + 41ms));
+    const auto oldest = history.at(t0 + 20ms);
+    REQUIRE(oldest);
+    CHECK(near(oldest->pos.x, 2.0));
+    const auto wrapped = history.at(t0 + 35ms);
+    REQUIRE(wrapped);
+    CHECK(near(wrapped->pos.x, 3.5));
+}
+
+TEST_CASE("Reprojection moves a point between body frames", "[pose-history]") {
+    using std::numbers::pi;
+    // Seen 1 m ahead from the origin, then from (1, 1) facing -y
+    const auto p = lrn::reproject({1.0, 0.0}, {{0.0, 0.0}, 0.0}, {{1.0, 1.0}, -pi / 2});
+    CHECK(near(p.x, 1.0));
+    CHECK(near(p.y, 0.0));
+}
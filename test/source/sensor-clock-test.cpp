@@ -0,0 +1,73 @@
+#include <liblrn/sensor-clock.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+
+using lrn::SensorClock;
+using namespace std::chrono_literals;
+
+namespace {
+// 256 sensor ticks are exactly 10 ms
+constexpr std::uint32_t ticks_10ms = 256;
+
+const SensorClock::clock::time_point t0 = SensorClock::clock::time_point{} + 100s;
+}
+
+TEST_CASE("First sample maps to its receive time", "[sensor-clock]") {
+    SensorClock clock;
+    CHECK(clock.to_host(1000, t0) == t0);
+}
+
+TEST_CASE("Offset follows the fastest sample", "[sensor-clock]") {
+    SensorClock clock;
+    // Received 3 ms late, then one on time: the later sample sets the offset
+    CHECK(clock.to_host(0, t0 + 3ms) == t0 + 3ms);
+    CHECK(clock.to_host(ticks_10ms, t0 + 10ms) == t0 + 10ms);
+
+    // A slow sample keeps the offset, up to the drift allowance
+    const auto stamp = clock.to_host(2 * ticks_10ms, t0 + 25ms);
+    CHECK(stamp >= t0 + 20ms);
+    CHECK(stamp < t0 + 21ms);
+}
+
+TEST_CASE("Counter wrap keeps the time monotonic", "[sensor-clock]") {
+    SensorClock clock;
+    const std::uint32_t before_wrap = 0xFFFFFFFFu - ticks_10ms + 1;
+    CHECK(clock.to_host(before_wrap, t0) == t0);
+    CHECK(clock.to_host(0, t0 + 10ms) == t0 + 10ms);
+    CHECK(clock.to_host(ticks_10ms, t0 + 20ms) == t0 + 20ms);
+}
+
+TEST_CASE("Counter restart resets the mapping", "[sensor-clock]") {
+    SensorClock clock;
+    const std::uint32_t running = 3600u * 25600u;    // an hour of sensor time
+    CHECK(clock.to_host(running, t0) == t0);
+    CHECK(clock.to_host(running + ticks_10ms, t0 + 10ms) == t0 + 10ms);
+
+    // Counter back near zero after an MCU reset, received 2 s later
+    CHECK(clock.to_host(ticks_10ms, t0 + 2s) == t0 + 2s);
+    CHECK(clock.to_host(2 * ticks_10ms, t0 + 2s + 10ms) == t0 + 2s + 10ms);
+}
+
+TEST_CASE("IMU frames older than an IR sample keep the mapping", "[sensor-clock]") {
+    SensorClock clock;
+    constexpr std::uint32_t ticks_5ms = ticks_10ms / 2;
+    const std::uint32_t start = 1000u * ticks_10ms;
+
+    // Each 20 ms an IR sample arrives 1 ms after its sensor time, then the
+    // IMU FIFO frames of the last 15 ms arrive behind it
+    for(std::uint32_t k = 0; k < 50; k++) {
+        const std::uint32_t ir_ticks = start + (k + 1) * 4 * ticks_5ms;
+        const auto ir_sent = t0 + (k + 1) * 20ms;
+        CHECK(clock.to_host(ir_ticks, ir_sent + 1ms) == ir_sent + 1ms);
+
+        for(std::uint32_t age : {3u, 2u, 1u}) {
+            const auto stamp = clock.to_host(ir_ticks - age * ticks_5ms, ir_sent + 2ms);
+            const auto expected = ir_sent - age * 5ms + 1ms;
+            CHECK(stamp >= expected);
+            CHECK(stamp < expected + 100us);
+        }
+    }
+}
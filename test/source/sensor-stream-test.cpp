@@ -0,0 +1,159 @@
+#include <liblrn/sensor-stream.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace lrn;
+
+namespace {
+
+void put_u16(std::vector<std::uint8_t>& out, std::uint16_t v) {
+    out.push_back(static_cast<std::uint8_t>(v & 0xFF));
+    out.push_back(static_cast<std::uint8_t>(v >> 8));
+}
+
+void put_u32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    put_u16(out, static_cast<std::uint16_t>(v & 0xFFFF));
+    put_u16(out, static_cast<std::uint16_t>(v >> 16));
+}
+
+// Frames a payload the way the firmware does (sensor_packet.h)
+std::vector<std::uint8_t> make_packet(std::uint8_t type, const std::vector<std::uint8_t>& payload) {
+    std::vector<std::uint8_t> packet {sensor_packet_sync0, sensor_packet_sync1, type, static_cast<std::uint8_t>(payload.size())};
+    packet.insert(packet.end(), payload.begin(), payload.end());
+    std::uint8_t a = 0;
+    std::uint8_t b = 0;
+    for(std::size_t k = 2; k < packet.size(); k++) {
+        a = static_cast<std::uint8_t>(a + packet[k]);
+        b = static_cast<std::uint8_t>(b + a);
+    }
+    packet.push_back(a);
+    packet.push_back(b);
+    return packet;
+}
+
+std::vector<std::uint8_t> imu_packet(std::int16_t gz, std::uint32_t sensor_time) {
+    std::vector<std::uint8_t> payload;
+    for(int v : {100, -200, 4096, 1, 2}) {
+        put_u16(payload, static_cast<std::uint16_t>(v));
+    }
+    put_u16(payload, static_cast<std::uint16_t>(gz));
+    put_u32(payload, sensor_time);
+    return make_packet(sensor_packet_type_imu, payload);
+}
+
+std::vector<std::uint8_t> ir_packet(std::uint16_t ir0, std::uint32_t sensor_time) {
+    std::vector<std::uint8_t> payload;
+    put_u16(payload, ir0);
+    put_u16(payload, 512);
+    put_u16(payload, 1023);
+    put_u32(payload, sensor_time);
+    return make_packet(sensor_packet_type_ir, payload);
+}
+
+std::vector<std::uint8_t> bytes(std::string_view text) {
+    return {text.begin(), text.end()};
+}
+
+void append(std::vector<std::uint8_t>& out, const std::vector<std::uint8_t>& more) {
+    out.insert(out.end(), more.begin(), more.end());
+}
+
+struct Collector {
+    std::vector<std::string> lines;
+    std::vector<SensorPacket> packets;
+
+    void feed(SensorStreamDecoder& decoder, const std::vector<std::uint8_t>& data) {
+        decoder.feed(data,
+            [this](std::string_view line) { lines.emplace_back(line); },
+            [this](const SensorPacket& packet) { packets.push_back(packet); });
+    }
+};
+
+} // namespace
+
+TEST_CASE("Lines are split across reads and lose their CR", "[sensor-stream]") {
+    SensorStreamDecoder decoder;
+    Collector out;
+    out.feed(decoder, bytes("<ir,3,1,2"));
+    CHECK(out.lines.empty());
+    out.feed(decoder, bytes(",3><time,1,5>\r\nREADY\n"));
+
+    REQUIRE(out.lines.size() == 2);
+    CHECK(out.lines[0] == "<ir,3,1,2,3><time,1,5>");
+    CHECK(out.lines[1] == "READY");
+    CHECK(out.packets.empty());
+}
+
+TEST_CASE("Packets are decoded between lines", "[sensor-stream]") {
+    SensorStreamDecoder decoder;
+    Collector out;
+    auto data = bytes("started\n");
+    append(data, imu_packet(-321, 0x01020304));
+    append(data, ir_packet(77, 0xA0B0C0D0));
+    append(data, bytes("done\n"));
+    out.feed(decoder, data);
+
+    REQUIRE(out.lines.size() == 2);
+    CHECK(out.lines[0] == "started");
+    CHECK(out.lines[1] == "done");
+
+    REQUIRE(out.packets.size() == 2);
+    CHECK(out.packets[0].type == sensor_packet_type_imu);
+    CHECK(out.packets[0].acc[0] == 100);
+    CHECK(out.packets[0].acc[1] == -200);
+    CHECK(out.packets[0].acc[2] == 4096);
+    CHECK(out.packets[0].gyr[2] == -321);
+    CHECK(out.packets[0].sensor_time == 0x01020304u);
+    CHECK(out.packets[1].type == sensor_packet_type_ir);
+    CHECK(out.packets[1].ir[0] == 77);
+    CHECK(out.packets[1].ir[2] == 1023);
+    CHECK(out.packets[1].sensor_time == 0xA0B0C0D0u);
+    CHECK(decoder.packets() == 2);
+    CHECK(decoder.checksum_errors() == 0);
+}
+
+TEST_CASE("A packet split byte by byte is reassembled", "[sensor-stream]") {
+    SensorStreamDecoder decoder;
+    Collector out;
+    for(std::uint8_t byte : imu_packet(5, 1234)) {
+        out.feed(decoder, {byte});
+    }
+    REQUIRE(out.packets.size() == 1);
+    CHECK(out.packets[0].gyr[2] == 5);
+    CHECK(out.packets[0].sensor_time == 1234u);
+    CHECK(out.lines.empty());
+}
+
+TEST_CASE("A corrupted packet is dropped and the next one found", "[sensor-stream]") {
+    SensorStreamDecoder decoder;
+    Collector out;
+    auto corrupted = imu_packet(1, 10);
+    corrupted[8] ^= 0x40;
+    auto data = corrupted;
+    append(data, imu_packet(2, 20));
+    out.feed(decoder, data);
+
+    REQUIRE(out.packets.size() == 1);
+    CHECK(out.packets[0].gyr[2] == 2);
+    CHECK(out.packets[0].sensor_time == 20u);
+    CHECK(decoder.checksum_errors() == 1);
+}
+
+TEST_CASE("A line cut by a packet is discarded", "[sensor-stream]") {
+    SensorStreamDecoder decoder;
+    Collector out;
+    auto data = bytes("<ir,3,1");
+    append(data, ir_packet(9, 30));
+    append(data, bytes("READY\n"));
+    out.feed(decoder, data);
+
+    REQUIRE(out.lines.size() == 1);
+    CHECK(out.lines[0] == "READY");
+    REQUIRE(out.packets.size() == 1);
+    CHECK(out.packets[0].ir[0] == 9);
+}